@@ -7,6 +7,7 @@
 #include "config.h"
 
 #include "../shared/config.h"
+#include "../shared/display.h"
 #include "../shared/log.h"
 #include "../squeek2lvgl/sq2lv.h"
 
@@ -42,12 +43,22 @@ static int parsing_handler(void* user_data, const char* section, const char* key
 
     if (strcmp(section, "theme") == 0) {
         if (strcmp(key, "default") == 0) {
-            bbx_themes_theme_id_t id = bbx_themes_find_theme_with_name(value);
+            bbx_themes_theme_id_t id = (value[0] == '/')
+                ? bbx_themes_load_theme(value) : bbx_themes_find_theme_with_name(value);
             if (id != BBX_THEMES_THEME_NONE) {
                 opts->theme.default_id = id;
                 return 1;
             }
         }
+    } else if (strcmp(section, "render") == 0) {
+        if (strcmp(key, "mode") == 0) {
+            if (bbx_display_find_render_mode_with_name(value, &(opts->render.mode))) {
+                return 1;
+            }
+        } else if (strcmp(key, "buffer_lines") == 0) {
+            opts->render.buffer_lines = strtoul(value, (char **)NULL, 10);
+            return 1;
+        }
     } else if (strcmp(section, "input") == 0) {
         if (strcmp(key, "pointer") == 0) {
             if (bbx_config_parse_bool(value, &(opts->input.pointer))) {
@@ -77,6 +88,8 @@ static int parsing_handler(void* user_data, const char* section, const char* key
 
 void bb_config_init_opts(bb_config_opts *opts) {
     opts->theme.default_id = BBX_THEMES_THEME_BREEZY_DARK;
+    opts->render.mode = LV_DISPLAY_RENDER_MODE_PARTIAL;
+    opts->render.buffer_lines = 0;
     opts->input.pointer = true;
     opts->input.touchscreen = true;
     opts->quirks.fbdev_force_refresh = false;
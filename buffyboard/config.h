@@ -19,6 +19,16 @@ typedef struct {
     bbx_themes_theme_id_t default_id;
 } bb_config_opts_theme;
 
+/**
+ * Options related to rendering
+ */
+typedef struct {
+    /* Render mode */
+    lv_display_render_mode_t mode;
+    /* Number of rows to render at a time in partial mode, 0 for the default */
+    uint32_t buffer_lines;
+} bb_config_opts_render;
+
 /**
  * Options related to input devices
  */
@@ -43,6 +53,8 @@ typedef struct {
 typedef struct {
     /* Options related to the theme */
     bb_config_opts_theme theme;
+    /* Options related to rendering */
+    bb_config_opts_render render;
     /* Options related to input devices */
     bb_config_opts_input input;
     /* Options related to (normally unneeded) quirks */
@@ -63,15 +63,6 @@
 /*Input device read period in milliseconds*/
 #define LV_INDEV_DEF_READ_PERIOD    30      /*[ms]*/
 
-/*Use a custom tick source that tells the elapsed time in milliseconds.
- *It removes the need to manually update the tick with `lv_tick_inc()`)*/
-uint32_t bb_get_tick(void);
-#define LV_TICK_CUSTOM     1
-#if LV_TICK_CUSTOM
-#define LV_TICK_CUSTOM_INCLUDE  <stdint.h>         /*Header for the system time function*/
-#define LV_TICK_CUSTOM_SYS_TIME_EXPR (bb_get_tick())     /*Expression evaluating to current system time in ms*/
-#endif   /*LV_TICK_CUSTOM*/
-
 /*Default Dot Per Inch. Used to initialize default sizes such as widgets sized, style paddings.
  *(Not so important, you can adjust it to modify default sizes and spaces)*/
 #define LV_DPI_DEF                  130     /*[px/inch]*/
@@ -611,7 +602,7 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
     #define LV_LINUX_FBDEV_BSD           0
     #define LV_LINUX_FBDEV_RENDER_MODE   LV_DISPLAY_RENDER_MODE_PARTIAL
     #define LV_LINUX_FBDEV_BUFFER_COUNT  0
-    #define LV_LINUX_FBDEV_BUFFER_SIZE   60
+    #define LV_LINUX_FBDEV_BUFFER_SIZE   1   /*Replaced by bbx_display_set_render_buffers, see shared/display.h*/
 #endif
 
 /*Driver for /dev/dri/card*/
@@ -12,11 +12,15 @@
 #include "uinput_device.h"
 
 #include "lvgl/lvgl.h"
+#include "lvgl/src/indev/lv_indev_private.h"
 
+#include "../shared/display.h"
+#include "../shared/event_loop.h"
 #include "../shared/indev.h"
 #include "../shared/log.h"
 #include "../shared/theme.h"
 #include "../shared/themes.h"
+#include "../shared/tick.h"
 #include "../squeek2lvgl/sq2lv.h"
 
 #include <limits.h>
@@ -25,7 +29,15 @@
 #include <stdlib.h>
 #include <unistd.h>
 
-#include <sys/time.h>
+#include <sys/epoll.h>
+
+
+/**
+ * Defines
+ */
+
+#define NUM_LATENCY_BUCKETS 8
+#define LATENCY_LOG_INTERVAL 50
 
 
 /**
@@ -38,6 +50,9 @@ bb_config_opts conf_opts;
 static bool resize_terminals = false;
 static lv_obj_t *keyboard = NULL;
 
+static unsigned long latency_histogram[NUM_LATENCY_BUCKETS] = { 0 };
+static unsigned long num_latency_samples = 0;
+
 
 /**
  * Static prototypes
@@ -67,6 +82,15 @@ static void sigaction_handler(int signum);
  */
 static void terminal_resize_timer_cb(lv_timer_t *timer);
 
+/**
+ * Handle changes of the active virtual terminal.
+ *
+ * @param fd VT monitor file descriptor
+ * @param events mask of epoll events that occurred
+ * @param user_data unused
+ */
+static void vt_monitor_cb(int fd, uint32_t events, void *user_data);
+
 /**
  * Handle LV_EVENT_VALUE_CHANGED events from the keyboard widget.
  * 
@@ -75,7 +99,7 @@ static void terminal_resize_timer_cb(lv_timer_t *timer);
 static void keyboard_value_changed_cb(lv_event_t *event);
 
 /**
- * Emit key down and up events for a key.
+ * Queue key down and up events for a key. The events are written with the next call to bb_uinput_device_flush.
  *
  * @param btn_id button index corresponding to the key
  * @param key_down true if a key down event should be emitted
@@ -84,10 +108,32 @@ static void keyboard_value_changed_cb(lv_event_t *event);
 static void emit_key_events(uint16_t btn_id, bool key_down, bool key_up);
 
 /**
- * Release any previously pressed modifier keys.
+ * Queue releases for any previously pressed modifier keys.
  */
 static void pop_checked_modifier_keys(void);
 
+/**
+ * Get the time at which the active input device was pressed.
+ *
+ * @return press time in ms
+ */
+static uint32_t get_press_time(void);
+
+/**
+ * Stamp subsequently queued key events with a time.
+ *
+ * @param time time in ms
+ */
+static void set_event_time(uint32_t time);
+
+/**
+ * Record the latency between a press and the emission of its key events and periodically log
+ * the latency histogram.
+ *
+ * @param press_time press time in ms
+ */
+static void record_latency(uint32_t press_time);
+
 
 /**
  * Static functions
@@ -110,6 +156,15 @@ static void terminal_resize_timer_cb(lv_timer_t *timer) {
     }
 }
 
+static void vt_monitor_cb(int fd, uint32_t events, void *user_data) {
+    LV_UNUSED(fd);
+    LV_UNUSED(events);
+    LV_UNUSED(user_data);
+    if (resize_terminals) {
+        bb_terminal_handle_vt_monitor_event();
+    }
+}
+
 static void keyboard_value_changed_cb(lv_event_t *event) {
     lv_obj_t *kb = lv_event_get_target(event);
 
@@ -118,8 +173,15 @@ static void keyboard_value_changed_cb(lv_event_t *event) {
         return;
     }
 
+    /* Keys with LV_BUTTONMATRIX_CTRL_CLICK_TRIG fire on release. Stamp their events with the current time and
+     * leave them out of the latency histogram which would otherwise include the time the key was held. */
+    bool is_triggered_on_press = !lv_buttonmatrix_has_button_ctrl(kb, btn_id, LV_BUTTONMATRIX_CTRL_CLICK_TRIG);
+    uint32_t trigger_time = is_triggered_on_press ? get_press_time() : bbx_tick_get();
+    set_event_time(trigger_time);
+
     if (sq2lv_is_layer_switcher(kb, btn_id)) {
         pop_checked_modifier_keys();
+        bb_uinput_device_flush();
         sq2lv_switch_layer(kb, btn_id);
         return;
     }
@@ -139,6 +201,12 @@ static void keyboard_value_changed_cb(lv_event_t *event) {
     if (!is_modifier) {
         pop_checked_modifier_keys();
     }
+
+    /* Write the whole chord to the device at once */
+    bb_uinput_device_flush();
+    if (is_triggered_on_press) {
+        record_latency(trigger_time);
+    }
 }
 
 static void emit_key_events(uint16_t btn_id, bool key_down, bool key_up) {
@@ -146,16 +214,21 @@ static void emit_key_events(uint16_t btn_id, bool key_down, bool key_up) {
     const int *scancodes = sq2lv_get_scancodes(keyboard, btn_id, &num_scancodes);
 
     if (key_down) {
-        /* Emit key down events in forward order */
+        /* Queue key down events in forward order */
         for (int i = 0; i < num_scancodes; ++i) {
-            bb_uinput_device_emit_key_down(scancodes[i]);
+            bb_uinput_device_queue_key_down(scancodes[i]);
         }
     }
 
+    if (key_down && key_up) {
+        /* Report the pressed keys in their own frame before releasing them */
+        bb_uinput_device_synchronise();
+    }
+
     if (key_up) {
-        /* Emit key up events in backward order */
+        /* Queue key up events in backward order */
         for (int i = num_scancodes - 1; i >= 0; --i) {
-            bb_uinput_device_emit_key_up(scancodes[i]);
+            bb_uinput_device_queue_key_up(scancodes[i]);
         }
     }
 }
@@ -167,11 +240,42 @@ static void pop_checked_modifier_keys(void) {
     for (int i = 0; i < num_modifiers; ++i) {
         if (!lv_buttonmatrix_has_button_ctrl(keyboard, modifier_idxs[i], LV_BUTTONMATRIX_CTRL_CHECKED)) {
             emit_key_events(modifier_idxs[i], false, true);
+
             lv_buttonmatrix_set_button_ctrl(keyboard, modifier_idxs[i], LV_BUTTONMATRIX_CTRL_CHECKED);
         }
     }
 }
 
+static uint32_t get_press_time(void) {
+    lv_indev_t *indev = lv_indev_active();
+    return indev ? indev->pr_timestamp : bbx_tick_get();
+}
+
+static void set_event_time(uint32_t time) {
+    struct timeval tv;
+    bbx_tick_to_timeval(time, &tv);
+    bb_uinput_device_set_event_time(&tv);
+}
+
+static void record_latency(uint32_t press_time) {
+    /* Bucket i counts latencies below 2^i ms, the last bucket everything above */
+    uint32_t latency = lv_tick_elaps(press_time);
+    int bucket = 0;
+    while (bucket < NUM_LATENCY_BUCKETS - 1 && latency >= (1u << bucket)) {
+        ++bucket;
+    }
+    ++latency_histogram[bucket];
+
+    if (++num_latency_samples % LATENCY_LOG_INTERVAL != 0) {
+        return;
+    }
+
+    bbx_log(BBX_LOG_LEVEL_VERBOSE, "Press to uinput latency after %lu key presses: "
+        "<1 ms: %lu, <2 ms: %lu, <4 ms: %lu, <8 ms: %lu, <16 ms: %lu, <32 ms: %lu, <64 ms: %lu, >=64 ms: %lu",
+        num_latency_samples, latency_histogram[0], latency_histogram[1], latency_histogram[2], latency_histogram[3],
+        latency_histogram[4], latency_histogram[5], latency_histogram[6], latency_histogram[7]);
+}
+
 
 /**
  * Main
@@ -193,14 +297,18 @@ int main(int argc, char *argv[]) {
     bb_config_parse_files(cli_opts.config_files, cli_opts.num_config_files, &conf_opts);
 
     /* Prepare for terminal resizing and reset */
+    bbx_event_loop_init();
     resize_terminals = bb_terminal_init(2.0f / 3.0f);
     if (resize_terminals) {
         /* Clean up on termination */
-        struct sigaction action;
-        lv_memset(&action, 0, sizeof(action));
-        action.sa_handler = sigaction_handler;
-        sigaction(SIGINT, &action, NULL);
-        sigaction(SIGTERM, &action, NULL);
+        const int signums[] = { SIGINT, SIGTERM };
+        if (!bbx_event_loop_handle_signals(signums, 2, sigaction_handler)) {
+            struct sigaction action;
+            lv_memset(&action, 0, sizeof(action));
+            action.sa_handler = sigaction_handler;
+            sigaction(SIGINT, &action, NULL);
+            sigaction(SIGTERM, &action, NULL);
+        }
 
         /* Resize current terminal */
         bb_terminal_shrink_current();
@@ -214,13 +322,19 @@ int main(int argc, char *argv[]) {
     /* Initialise lvgl */
     lv_init();
 
+    /* Use the monotonic clock as tick source */
+    lv_tick_set_cb(bbx_tick_get);
+
     /* Initialise display */
     lv_display_t *disp = lv_linux_fbdev_create();
     lv_linux_fbdev_set_file(disp, "/dev/fb0");
-    if (conf_opts.quirks.fbdev_force_refresh) {
+    if (conf_opts.quirks.fbdev_force_refresh && !bbx_display_set_fbdev_force_refresh(disp, "/dev/fb0")) {
         lv_linux_fbdev_set_force_refresh(disp, true);
     }
 
+    /* Account for flushed areas to make partial redraws verifiable */
+    bbx_display_track_flushes(disp);
+
     /* Override display properties with command line options if necessary */
     lv_display_set_offset(disp, cli_opts.x_offset, cli_opts.y_offset);
     if (cli_opts.hor_res > 0 || cli_opts.ver_res > 0) {
@@ -253,11 +367,14 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    /* Size the render buffers for the keyboard strip which is all that the display covers */
+    bbx_display_set_render_buffers(disp, conf_opts.render.mode, conf_opts.render.buffer_lines);
+
     /* Start input device monitor and auto-connect available devices */
     bbx_indev_start_monitor_and_autoconnect(false, conf_opts.input.pointer, conf_opts.input.touchscreen);
 
     /* Initialise theme */
-    bbx_theme_apply(bbx_themes_themes[conf_opts.theme.default_id]);
+    bbx_theme_apply(bbx_themes_get_theme(conf_opts.theme.default_id));
 
     /* Add keyboard */
     keyboard = lv_keyboard_create(lv_scr_act());
@@ -276,40 +393,18 @@ int main(int argc, char *argv[]) {
     /* Apply default keyboard layout */
     sq2lv_switch_layout(keyboard, SQ2LV_LAYOUT_TERMINAL_US);
 
-    /* Start timer for periodically resizing terminals */
-    lv_timer_create(terminal_resize_timer_cb, 1000,  NULL);
-
-    /* Periodically run timer / task handler */
-    while(1) {
-        lv_timer_periodic_handler();
+    /* Resize terminals as soon as they become active. If VT changes cannot be monitored, fall back
+     * to periodically resizing the current terminal. */
+    if (resize_terminals) {
+        int vt_monitor_fd = bb_terminal_start_vt_monitor();
+        if (vt_monitor_fd < 0 || !bbx_event_loop_add_fd(vt_monitor_fd, EPOLLPRI, vt_monitor_cb, NULL)) {
+            lv_timer_create(terminal_resize_timer_cb, 1000,  NULL);
+        }
     }
 
+    /* Run timers and handle input until we exit */
+    bbx_event_loop_run();
+
     return 0;
 }
 
-
-/**
- * Tick generation
- */
-
-/**
- * Generate tick for LVGL.
- * 
- * @return tick in ms
- */
-uint32_t bb_get_tick(void) {
-    static uint64_t start_ms = 0;
-    if (start_ms == 0) {
-        struct timeval tv_start;
-        gettimeofday(&tv_start, NULL);
-        start_ms = (tv_start.tv_sec * 1000000 + tv_start.tv_usec) / 1000;
-    }
-
-    struct timeval tv_now;
-    gettimeofday(&tv_now, NULL);
-    uint64_t now_ms;
-    now_ms = (tv_now.tv_sec * 1000000 + tv_now.tv_usec) / 1000;
-
-    uint32_t time_ms = now_ms - start_ms;
-    return time_ms;
-}
@@ -13,19 +13,36 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <linux/fb.h>
+#include <linux/kd.h>
 #include <linux/vt.h>
 
 #include <sys/ioctl.h>
 
 
+/**
+ * Defines
+ */
+
+#define ACTIVE_VT_SYSFS_PATH "/sys/class/tty/tty0/active"
+#define FBCON_ROTATE_SYSFS_PATH "/sys/class/graphics/fbcon/rotate"
+#define FRAMEBUFFER_PATH "/dev/fb0"
+
+/* Upper limits for console font dimensions accepted by KDFONTOP */
+#define MAX_FONT_WIDTH 64
+#define MAX_FONT_HEIGHT 128
+
+
 /**
  * Static variables
  */
 
 static int current_fd = -1;
 static int current_vt = -1;
-static bool resized_vts[MAX_NR_CONSOLES];
+static struct winsize resized_vts[MAX_NR_CONSOLES]; /* Maximum sizes of resized VTs, ws_row is 0 for others */
+static int framebuffer_height = -1;
 static float height_factor = 1;
+static int monitor_fd = -1;
 
 
 /**
@@ -51,6 +68,21 @@ static void close_current_terminal(void);
  */
 static int get_active_terminal(void);
 
+/**
+ * Read the currently active virtual terminal from the sysfs monitor file. This also
+ * re-arms the file for the next change notification.
+ *
+ * @return number of the active VT (e.g. 7 for /dev/tty7) or -1 on failure
+ */
+static int read_active_terminal_from_monitor(void);
+
+/**
+ * Shrink a virtual terminal unless it was resized before.
+ *
+ * @param vt number of the VT (e.g. 7 for /dev/tty7)
+ */
+static void shrink_vt(int vt);
+
 /**
  * Retrieve a terminal's size.
  * 
@@ -71,16 +103,35 @@ static bool get_terminal_size(int fd, struct winsize *size);
  */
 static bool set_terminal_size(int fd, struct winsize *size);
 
+/**
+ * Get the height of the framebuffer in the console's orientation. The value is cached after the
+ * first successful query.
+ *
+ * @return height in pixels or -1 on failure
+ */
+static int get_framebuffer_height(void);
+
+/**
+ * Compute the maximum size of a terminal from the framebuffer geometry and the console font height.
+ *
+ * @param fd TTY file descriptor
+ * @param size pointer to winsize struct holding the current size and for writing the maximum size into
+ * @return true if the operation was successful, false otherwise
+ */
+static bool compute_max_terminal_size(int fd, struct winsize *size);
+
 /**
  * Shrink the height of a terminal by the current factor.
  * 
  * @param fd TTY file descriptor
+ * @param max_size pointer to winsize struct for writing the terminal's maximum size into
  * @return true if the operation was successful, false otherwise
  */
-static bool shrink_terminal(int fd);
+static bool shrink_terminal(int fd, struct winsize *max_size);
 
 /**
- * Reset the height of a terminal to the maximum.
+ * Reset the height of a terminal to the maximum by resizing it row by row. Only used as a
+ * fallback when the maximum size cannot be computed.
  * 
  * @param fd TTY file descriptor
  * @param size pointer to winsize struct for writing the final size into
@@ -123,6 +174,55 @@ static int get_active_terminal(void) {
     return stat.v_active;
 }
 
+static int read_active_terminal_from_monitor(void) {
+    char buf[16];
+
+    if (lseek(monitor_fd, 0, SEEK_SET) < 0) {
+        perror("Could not rewind active terminal monitor");
+        return -1;
+    }
+
+    ssize_t len = read(monitor_fd, buf, sizeof(buf) - 1);
+    if (len <= 0) {
+        perror("Could not read active terminal from monitor");
+        return -1;
+    }
+    buf[len] = '\0';
+
+    int vt = -1;
+    if (sscanf(buf, "tty%d", &vt) != 1) {
+        fprintf(stderr, "Could not parse active terminal \"%s\"\n", buf);
+        return -1;
+    }
+
+    return vt;
+}
+
+static void shrink_vt(int vt) {
+    if (vt < 1 || vt > MAX_NR_CONSOLES) {
+        perror("Could not resize current terminal, index is out of bounds");
+        return;
+    }
+
+    if (resized_vts[vt - 1].ws_row > 0) {
+        return; /* Already resized */
+    }
+
+    if (vt != current_vt) {
+        if (!reopen_current_terminal()) {
+            perror("Could not resize current terminal");
+            return;
+        }
+        current_vt = vt;
+    }
+
+    if (!shrink_terminal(current_fd, &resized_vts[current_vt - 1])) {
+        perror("Could not resize current terminal");
+        resized_vts[current_vt - 1].ws_row = 0;
+        return;
+    }
+}
+
 static bool get_terminal_size(int fd, struct winsize *size) {
 	if (ioctl(fd, TIOCGWINSZ, size) != 0) {
         int errsv = errno;
@@ -143,14 +243,74 @@ static bool set_terminal_size(int fd, struct winsize *size) {
     return true;
 }
 
-static bool shrink_terminal(int fd) {
-    struct winsize size = { 0, 0, 0, 0 };
-    
-    if (!reset_terminal(fd, &size)) {
+static int get_framebuffer_height(void) {
+    if (framebuffer_height > 0) {
+        return framebuffer_height;
+    }
+
+    int fd = open(FRAMEBUFFER_PATH, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        perror("Could not open " FRAMEBUFFER_PATH);
+        return -1;
+    }
+
+    struct fb_var_screeninfo info;
+    int result = ioctl(fd, FBIOGET_VSCREENINFO, &info);
+    close(fd);
+    if (result != 0) {
+        perror("Could not retrieve framebuffer geometry");
+        return -1;
+    }
+
+    /* fbcon swaps the axes when the console is rotated by 90 or 270 degrees */
+    int rotation = 0;
+    FILE *file = fopen(FBCON_ROTATE_SYSFS_PATH, "r");
+    if (file) {
+        if (fscanf(file, "%d", &rotation) != 1) {
+            rotation = 0;
+        }
+        fclose(file);
+    }
+
+    framebuffer_height = (rotation % 2 == 0) ? info.yres : info.xres;
+    return framebuffer_height;
+}
+
+static bool compute_max_terminal_size(int fd, struct winsize *size) {
+    int height = get_framebuffer_height();
+    if (height <= 0) {
+        return false;
+    }
+
+    /* Without a data buffer, the kernel only reports the font dimensions */
+    struct console_font_op font = {
+        .op = KD_FONT_OP_GET,
+        .width = MAX_FONT_WIDTH,
+        .height = MAX_FONT_HEIGHT,
+        .data = NULL
+    };
+    if (ioctl(fd, KDFONTOP, &font) != 0 || font.height == 0) {
+        perror("Could not retrieve console font size");
+        return false;
+    }
+
+    size->ws_row = height / font.height;
+    return size->ws_row > 0;
+}
+
+static bool shrink_terminal(int fd, struct winsize *max_size) {
+    if (!get_terminal_size(fd, max_size)) {
         perror("Could not shrink terminal size");
         return false;
     }
 
+    /* Derive the maximum size from the geometry and only probe row by row if that isn't possible */
+    if (!compute_max_terminal_size(fd, max_size) && !reset_terminal(fd, max_size)) {
+        perror("Could not shrink terminal size");
+        return false;
+    }
+
+    struct winsize size = *max_size;
     size.ws_row = floor((float)size.ws_row * height_factor);
     if (!set_terminal_size(fd, &size)) {
         perror("Could not shrink terminal size");
@@ -235,37 +395,49 @@ void bb_terminal_shrink_current(void) {
         return;
     }
 
-    if (active_vt < 0 || active_vt > MAX_NR_CONSOLES - 1) {
-        perror("Could not resize current terminal, index is out of bounds");
-        return;
+    shrink_vt(active_vt);
+}
+
+int bb_terminal_start_vt_monitor(void) {
+    if (monitor_fd >= 0) {
+        return monitor_fd;
     }
 
-    if (resized_vts[active_vt - 1]) {
-        return; /* Already resized */
+    monitor_fd = open(ACTIVE_VT_SYSFS_PATH, O_RDONLY | O_CLOEXEC);
+    if (monitor_fd < 0) {
+        perror("Could not open " ACTIVE_VT_SYSFS_PATH);
+        return -1;
     }
 
-    if (active_vt != current_vt) {
-        if (!reopen_current_terminal()) {
-            perror("Could not resize current terminal");
-            return;
-        }
-        current_vt = active_vt;
+    /* Consume the current value to arm the notification and catch up with switches that already happened */
+    int active_vt = read_active_terminal_from_monitor();
+    if (active_vt < 0) {
+        close(monitor_fd);
+        monitor_fd = -1;
+        return -1;
     }
+    shrink_vt(active_vt);
 
-    if (!shrink_terminal(current_fd)) {
-        perror("Could not resize current terminal");
+    return monitor_fd;
+}
+
+void bb_terminal_handle_vt_monitor_event(void) {
+    if (monitor_fd < 0) {
         return;
     }
 
-    resized_vts[current_vt - 1] = true;
+    int active_vt = read_active_terminal_from_monitor();
+    if (active_vt < 0) {
+        return;
+    }
+    shrink_vt(active_vt);
 }
 
 void bb_terminal_reset_all(void) {
     char device[16];
-    struct winsize size = { 0, 0, 0, 0 };
 
     for (int i = 0; i < MAX_NR_CONSOLES; ++i) {
-        if (!resized_vts[i]) {
+        if (resized_vts[i].ws_row == 0) {
             continue;
         }
 
@@ -276,6 +448,12 @@ void bb_terminal_reset_all(void) {
             continue;
         }
 
-        reset_terminal(fd, &size);
+        /* Restore the cached maximum size, falling back to probing if it doesn't fit anymore */
+        if (!set_terminal_size(fd, &resized_vts[i])) {
+            struct winsize size = { 0, 0, 0, 0 };
+            reset_terminal(fd, &size);
+        }
+
+        close(fd);
     }
 }
@@ -23,6 +23,20 @@ bool bb_terminal_init(float factor);
  */
 void bb_terminal_shrink_current(void);
 
+/**
+ * Start monitoring the active virtual terminal via sysfs. The returned file descriptor signals
+ * EPOLLPRI whenever another terminal becomes active, upon which bb_terminal_handle_vt_monitor_event
+ * should be called.
+ *
+ * @return file descriptor to watch or -1 if VT changes cannot be monitored
+ */
+int bb_terminal_start_vt_monitor(void);
+
+/**
+ * Shrink the height of the newly active terminal after the VT monitor signalled a change.
+ */
+void bb_terminal_handle_vt_monitor_event(void);
+
 /**
  * Re-maximise the height of all previously resized terminals.
  */
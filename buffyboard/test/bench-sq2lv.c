@@ -0,0 +1,174 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#include "../sq2lv_layouts.h"
+#include "../../shared/tick.h"
+#include "../../squeek2lvgl/sq2lv.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/**
+ * Defines
+ */
+
+#define NUM_ITERATIONS 100000
+#define NUM_SWITCHES 10000
+
+
+/**
+ * Static variables
+ */
+
+/* Prevents the compiler from optimising the classification away */
+static volatile int sink = 0;
+
+static const lv_keyboard_mode_t modes[] = {
+    LV_KEYBOARD_MODE_TEXT_LOWER, LV_KEYBOARD_MODE_TEXT_UPPER, LV_KEYBOARD_MODE_SPECIAL, LV_KEYBOARD_MODE_NUMBER,
+    LV_KEYBOARD_MODE_USER_1, LV_KEYBOARD_MODE_USER_2, LV_KEYBOARD_MODE_USER_3, LV_KEYBOARD_MODE_USER_4
+};
+
+
+/**
+ * Static prototypes
+ */
+
+/**
+ * Classify a key by linearly scanning the switcher and modifier indexes, like sq2lv used to do.
+ *
+ * @param layer current layer
+ * @param btn_id button index corresponding to the key
+ * @return a value depending on the key's class
+ */
+static int classify_with_scan(const sq2lv_layer_t *layer, uint16_t btn_id);
+
+/**
+ * Classify a key with the same calls that buffyboard makes for every key press.
+ *
+ * @param keyboard keyboard widget
+ * @param btn_id button index corresponding to the key
+ * @return a value depending on the key's class
+ */
+static int classify_with_api(lv_obj_t *keyboard, uint16_t btn_id);
+
+/**
+ * Classify every key in a layer a number of times and print the per-key cost.
+ *
+ * @param name name of the benchmark
+ * @param keyboard keyboard widget
+ * @param layer current layer
+ * @param use_api true to use the sq2lv API, false to use the linear scan
+ */
+static void run(const char *name, lv_obj_t *keyboard, const sq2lv_layer_t *layer, bool use_api);
+
+/**
+ * Repeatedly press the first layer switcher of the current layer and print the per-switch cost.
+ *
+ * @param keyboard keyboard widget
+ * @param layout_id layout to switch layers in
+ */
+static void run_layer_switches(lv_obj_t *keyboard, sq2lv_layout_id_t layout_id);
+
+
+/**
+ * Static functions
+ */
+
+static int classify_with_scan(const sq2lv_layer_t *layer, uint16_t btn_id) {
+    for (int i = 0; i < layer->num_switchers; ++i) {
+        if (layer->switcher_idxs[i] == btn_id) {
+            return layer->switcher_dests[i];
+        }
+    }
+    for (int i = 0; i < layer->num_modifiers; ++i) {
+        if (layer->modifier_idxs[i] == btn_id) {
+            return -1;
+        }
+    }
+    return layer->scancode_nums[btn_id];
+}
+
+static int classify_with_api(lv_obj_t *keyboard, uint16_t btn_id) {
+    if (sq2lv_is_layer_switcher(keyboard, btn_id)) {
+        return 0;
+    }
+    if (sq2lv_is_modifier(keyboard, btn_id)) {
+        return -1;
+    }
+    int num_scancodes = 0;
+    sq2lv_get_scancodes(keyboard, btn_id, &num_scancodes);
+    return num_scancodes;
+}
+
+static void run(const char *name, lv_obj_t *keyboard, const sq2lv_layer_t *layer, bool use_api) {
+    uint64_t start = bbx_tick_get_us();
+
+    for (int i = 0; i < NUM_ITERATIONS; ++i) {
+        for (uint16_t btn_id = 0; btn_id < layer->num_keys; ++btn_id) {
+            sink += use_api ? classify_with_api(keyboard, btn_id) : classify_with_scan(layer, btn_id);
+        }
+    }
+
+    double elapsed = bbx_tick_get_us() - start;
+    printf("%-32s %8.2f ns/key\n", name, elapsed * 1e3 / NUM_ITERATIONS / layer->num_keys);
+}
+
+static void run_layer_switches(lv_obj_t *keyboard, sq2lv_layout_id_t layout_id) {
+    sq2lv_switch_layout(keyboard, layout_id);
+    uint64_t start = bbx_tick_get_us();
+
+    for (int i = 0; i < NUM_SWITCHES; ++i) {
+        int layer_index = 0;
+        while (modes[layer_index] != lv_keyboard_get_mode(keyboard)) {
+            ++layer_index;
+        }
+
+        const sq2lv_layer_t *layer = &(sq2lv_layouts[layout_id].layers[layer_index]);
+        for (uint16_t btn_id = 0; btn_id < layer->num_keys; ++btn_id) {
+            if (sq2lv_switch_layer(keyboard, btn_id)) {
+                break;
+            }
+        }
+    }
+
+    double elapsed = bbx_tick_get_us() - start;
+    printf("%-32s %8.2f us/switch\n", sq2lv_layouts[layout_id].short_name, elapsed / NUM_SWITCHES);
+}
+
+
+/**
+ * Main
+ */
+
+int main(void) {
+    lv_init();
+    lv_display_create(800, 480);
+
+    lv_obj_t *keyboard = lv_keyboard_create(lv_screen_active());
+    lv_obj_set_size(keyboard, 800, 240);
+    lv_obj_update_layout(keyboard);
+
+    for (int i = 0; i < sq2lv_num_layouts; ++i) {
+        sq2lv_switch_layout(keyboard, i);
+
+        for (int j = 0; j < sq2lv_layouts[i].num_layers; ++j) {
+            lv_keyboard_set_mode(keyboard, modes[j]);
+
+            char name[32];
+            snprintf(name, sizeof(name), "%s/%d, scan", sq2lv_layouts[i].short_name, j);
+            run(name, keyboard, &(sq2lv_layouts[i].layers[j]), false);
+            snprintf(name, sizeof(name), "%s/%d, table", sq2lv_layouts[i].short_name, j);
+            run(name, keyboard, &(sq2lv_layouts[i].layers[j]), true);
+        }
+    }
+
+    for (int i = 0; i < sq2lv_num_layouts; ++i) {
+        run_layer_switches(keyboard, i);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,233 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#include "../sq2lv_layouts.h"
+#include "../../shared/theme.h"
+#include "../../shared/themes.h"
+#include "../../shared/tick.h"
+#include "../../squeek2lvgl/sq2lv.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/**
+ * Defines
+ */
+
+#define WIDTH 800
+#define HEIGHT 240
+#define NUM_FRAMES 500
+
+
+/**
+ * Static variables
+ */
+
+/* Key colors as hex values, the way themes stored them before the draw hook used precomputed colors */
+typedef struct {
+    uint32_t fg_color;
+    uint32_t bg_color;
+    uint32_t border_color;
+} hex_key_state;
+
+typedef struct {
+    hex_key_state normal;
+    hex_key_state pressed;
+} hex_key;
+
+static hex_key hex_key_char;
+static hex_key hex_key_non_char;
+static hex_key hex_key_mod_act;
+static hex_key hex_key_mod_inact;
+
+
+/**
+ * Static prototypes
+ */
+
+/**
+ * Convert a key theme into hex values.
+ *
+ * @param key key theme
+ * @param hex_key hex key to fill
+ */
+static void init_hex_key(const bbx_theme_key *key, hex_key *hex_key);
+
+/**
+ * Handle LV_EVENT_DRAW_TASK_ADDED events on the keyboard the way the theme did before key colors were precomputed,
+ * i.e. by classifying the key and converting its colors for every draw task.
+ *
+ * @param event the event object
+ */
+static void old_keyboard_draw_task_added_cb(lv_event_t *event);
+
+/**
+ * Create a keyboard covering the display.
+ *
+ * @param old_hook true to style keys with the old draw hook, false to use the theme's hook
+ * @return the keyboard widget
+ */
+static lv_obj_t *create_keyboard(bool old_hook);
+
+/**
+ * Discard rendered frames.
+ *
+ * @param disp display to flush
+ * @param area area to flush
+ * @param px_map pixels to flush
+ */
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
+
+/**
+ * Redraw the keyboard a number of times and print the per-frame cost.
+ *
+ * @param name name of the benchmark
+ * @param disp display to render on
+ * @param keyboard keyboard widget
+ * @param slide true to move the keyboard between frames like during a slide animation, false to redraw it in place
+ */
+static void run(const char *name, lv_display_t *disp, lv_obj_t *keyboard, bool slide);
+
+
+/**
+ * Static functions
+ */
+
+static void init_hex_key(const bbx_theme_key *key, hex_key *hex_key) {
+    hex_key->normal.fg_color = lv_color_to_u32(key->normal.fg_color) & 0xFFFFFF;
+    hex_key->normal.bg_color = lv_color_to_u32(key->normal.bg_color) & 0xFFFFFF;
+    hex_key->normal.border_color = lv_color_to_u32(key->normal.border_color) & 0xFFFFFF;
+    hex_key->pressed.fg_color = lv_color_to_u32(key->pressed.fg_color) & 0xFFFFFF;
+    hex_key->pressed.bg_color = lv_color_to_u32(key->pressed.bg_color) & 0xFFFFFF;
+    hex_key->pressed.border_color = lv_color_to_u32(key->pressed.border_color) & 0xFFFFFF;
+}
+
+static void old_keyboard_draw_task_added_cb(lv_event_t *event) {
+    lv_obj_t *obj = lv_event_get_target(event);
+    lv_buttonmatrix_t *btnm = (lv_buttonmatrix_t *)obj;
+    lv_draw_task_t *draw_task = lv_event_get_draw_task(event);
+    lv_draw_dsc_base_t *dsc = draw_task->draw_dsc;
+
+    if (dsc->part != LV_PART_ITEMS) {
+        return;
+    }
+
+    hex_key *key = NULL;
+
+    if ((btnm->ctrl_bits[dsc->id1] & SQ2LV_CTRL_MOD_INACTIVE) == SQ2LV_CTRL_MOD_INACTIVE) {
+        key = &hex_key_mod_inact;
+    } else if ((btnm->ctrl_bits[dsc->id1] & SQ2LV_CTRL_MOD_ACTIVE) == SQ2LV_CTRL_MOD_ACTIVE) {
+        key = &hex_key_mod_act;
+    } else if ((btnm->ctrl_bits[dsc->id1] & SQ2LV_CTRL_NON_CHAR) == SQ2LV_CTRL_NON_CHAR) {
+        key = &hex_key_non_char;
+    } else {
+        key = &hex_key_char;
+    }
+
+    bool pressed = lv_buttonmatrix_get_selected_button(obj) == dsc->id1 && lv_obj_has_state(obj, LV_STATE_PRESSED);
+
+    lv_draw_label_dsc_t *label_dsc = lv_draw_task_get_label_dsc(draw_task);
+    if (label_dsc) {
+        label_dsc->color = lv_color_hex((pressed ? key->pressed : key->normal).fg_color);
+    }
+
+    lv_draw_fill_dsc_t *fill_dsc = lv_draw_task_get_fill_dsc(draw_task);
+    if (fill_dsc) {
+        fill_dsc->color = lv_color_hex((pressed ? key->pressed : key->normal).bg_color);
+    }
+
+    lv_draw_border_dsc_t *border_dsc = lv_draw_task_get_border_dsc(draw_task);
+    if (border_dsc) {
+        border_dsc->color = lv_color_hex((pressed ? key->pressed : key->normal).border_color);
+    }
+}
+
+static lv_obj_t *create_keyboard(bool old_hook) {
+    lv_obj_t *keyboard = lv_keyboard_create(lv_screen_active());
+    lv_obj_set_size(keyboard, WIDTH, HEIGHT);
+
+    if (old_hook) {
+        lv_obj_add_event_cb(keyboard, old_keyboard_draw_task_added_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
+        lv_obj_add_flag(keyboard, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    } else {
+        bbx_theme_prepare_keyboard(keyboard);
+    }
+
+    return keyboard;
+}
+
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    LV_UNUSED(area);
+    LV_UNUSED(px_map);
+    lv_display_flush_ready(disp);
+}
+
+static void run(const char *name, lv_display_t *disp, lv_obj_t *keyboard, bool slide) {
+    uint64_t start = bbx_tick_get_us();
+
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        if (slide) {
+            lv_obj_set_y(keyboard, i % HEIGHT);
+        } else {
+            lv_obj_invalidate(keyboard);
+        }
+        lv_refr_now(disp);
+    }
+
+    double elapsed = bbx_tick_get_us() - start;
+    printf("%-40s %8.2f us/frame\n", name, elapsed / NUM_FRAMES);
+}
+
+
+/**
+ * Main
+ */
+
+int main(void) {
+    lv_init();
+
+    lv_display_t *disp = lv_display_create(WIDTH, HEIGHT);
+    uint32_t buf_size = WIDTH * HEIGHT * lv_color_format_get_size(lv_display_get_color_format(disp));
+    void *buf = malloc(buf_size);
+    if (!buf) {
+        return EXIT_FAILURE;
+    }
+    lv_display_set_buffers(disp, buf, NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+
+    const bbx_theme *theme = bbx_themes_themes[0];
+    bbx_theme_apply(theme);
+
+    init_hex_key(&(theme->keyboard.keys.key_char), &hex_key_char);
+    init_hex_key(&(theme->keyboard.keys.key_non_char), &hex_key_non_char);
+    init_hex_key(&(theme->keyboard.keys.key_mod_act), &hex_key_mod_act);
+    init_hex_key(&(theme->keyboard.keys.key_mod_inact), &hex_key_mod_inact);
+
+    lv_obj_t *keyboards[2] = { create_keyboard(false), create_keyboard(true) };
+    const char *hook_names[2] = { "new hook", "old hook" };
+
+    for (int i = 0; i < sq2lv_num_layouts; ++i) {
+        for (int k = 0; k < 2; ++k) {
+            lv_obj_t *keyboard = keyboards[k];
+            lv_obj_add_flag(keyboards[1 - k], LV_OBJ_FLAG_HIDDEN);
+            lv_obj_clear_flag(keyboard, LV_OBJ_FLAG_HIDDEN);
+            sq2lv_switch_layout(keyboard, i);
+            lv_refr_now(disp);
+
+            char name[48];
+            snprintf(name, sizeof(name), "%s, redraw, %s", sq2lv_layouts[i].short_name, hook_names[k]);
+            run(name, disp, keyboard, false);
+            snprintf(name, sizeof(name), "%s, slide, %s", sq2lv_layouts[i].short_name, hook_names[k]);
+            run(name, disp, keyboard, true);
+            lv_obj_set_y(keyboard, 0);
+        }
+    }
+
+    free(buf);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,207 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#include "../uinput_device.h"
+#include "../../shared/tick.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <linux/uinput.h>
+
+
+/**
+ * Defines
+ */
+
+#define NUM_CHARACTERS 10000
+
+
+/**
+ * Static variables
+ */
+
+/* Keys that are unmapped in the default console keymap so that the benchmark doesn't type into the active terminal */
+static const int scancodes[] = { KEY_LEFTSHIFT, KEY_F24 };
+static const int num_scancodes = sizeof(scancodes) / sizeof(scancodes[0]);
+
+/* Separate device and counters for emitting events the way buffyboard used to */
+static int unbatched_fd = -1;
+static bb_uinput_device_stats unbatched_stats = { 0 };
+
+
+/**
+ * Static prototypes
+ */
+
+/**
+ * Create the device used by emit_unbatched.
+ *
+ * @return true if creating the device was successful, false otherwise
+ */
+static bool init_unbatched(void);
+
+/**
+ * Write a single event to the unbatched device.
+ *
+ * @param type event type
+ * @param code event code
+ * @param value event value
+ */
+static void write_unbatched(int type, int code, int value);
+
+/**
+ * Emit a key chord using one immediate write per event, like buffyboard used to do.
+ *
+ * @param chord scancodes to press in forward and release in backward order
+ * @param num_keys number of scancodes in chord
+ */
+static void emit_unbatched(const int *chord, int num_keys);
+
+/**
+ * Emit a key chord using the batching API.
+ *
+ * @param chord scancodes to press in forward and release in backward order
+ * @param num_keys number of scancodes in chord
+ */
+static void emit_batched(const int *chord, int num_keys);
+
+/**
+ * Emit a number of characters and print the per-character cost.
+ *
+ * @param name name of the benchmark
+ * @param stats counters of the device written to by emit
+ * @param emit function to emit a single chord
+ * @param chord scancodes to press in forward and release in backward order
+ * @param num_keys number of scancodes in chord
+ */
+static void run(const char *name, const bb_uinput_device_stats *stats, void (*emit)(const int *, int),
+    const int *chord, int num_keys);
+
+
+/**
+ * Static functions
+ */
+
+static bool init_unbatched(void) {
+    unbatched_fd = open("/dev/uinput", O_WRONLY | O_NONBLOCK);
+    if (unbatched_fd < 0) {
+        perror("Could not open /dev/uinput");
+        return false;
+    }
+
+    if (ioctl(unbatched_fd, UI_SET_EVBIT, EV_KEY) < 0 || ioctl(unbatched_fd, UI_SET_EVBIT, EV_SYN) < 0) {
+        perror("Could not set EVBIT");
+        return false;
+    }
+
+    for (int i = 0; i < num_scancodes; ++i) {
+        if (ioctl(unbatched_fd, UI_SET_KEYBIT, scancodes[i]) < 0) {
+            perror("Could not set KEYBIT");
+            return false;
+        }
+    }
+
+    struct uinput_setup setup;
+    memset(&setup, 0, sizeof(setup));
+    strcpy(setup.name, "bench-uinput-device");
+    setup.id.bustype = BUS_USB;
+    setup.id.vendor = 1;
+    setup.id.product = 2;
+    setup.id.version = 1;
+
+    if (ioctl(unbatched_fd, UI_DEV_SETUP, &setup) < 0 || ioctl(unbatched_fd, UI_DEV_CREATE) < 0) {
+        perror("Could not create uinput device");
+        return false;
+    }
+
+    return true;
+}
+
+static void write_unbatched(int type, int code, int value) {
+    struct input_event event;
+    memset(&event, 0, sizeof(event));
+    event.type = type;
+    event.code = code;
+    event.value = value;
+
+    if (write(unbatched_fd, &event, sizeof(event)) != sizeof(event)) {
+        perror("Could not emit event");
+    }
+
+    unbatched_stats.num_writes++;
+    unbatched_stats.num_events++;
+    if (type == EV_SYN) {
+        unbatched_stats.num_frames++;
+    }
+}
+
+static void emit_unbatched(const int *chord, int num_keys) {
+    for (int i = 0; i < num_keys; ++i) {
+        write_unbatched(EV_KEY, chord[i], 1);
+        write_unbatched(EV_SYN, SYN_REPORT, 0);
+    }
+    for (int i = num_keys - 1; i >= 0; --i) {
+        write_unbatched(EV_KEY, chord[i], 0);
+        write_unbatched(EV_SYN, SYN_REPORT, 0);
+    }
+}
+
+static void emit_batched(const int *chord, int num_keys) {
+    for (int i = 0; i < num_keys; ++i) {
+        bb_uinput_device_queue_key_down(chord[i]);
+    }
+    bb_uinput_device_synchronise();
+    for (int i = num_keys - 1; i >= 0; --i) {
+        bb_uinput_device_queue_key_up(chord[i]);
+    }
+    bb_uinput_device_flush();
+}
+
+static void run(const char *name, const bb_uinput_device_stats *stats, void (*emit)(const int *, int),
+    const int *chord, int num_keys) {
+    bb_uinput_device_stats before = *stats;
+    uint64_t start = bbx_tick_get_us();
+
+    for (int i = 0; i < NUM_CHARACTERS; ++i) {
+        emit(chord, num_keys);
+    }
+
+    double elapsed = bbx_tick_get_us() - start;
+    const bb_uinput_device_stats *after = stats;
+
+    printf("%-24s %6.2f syscalls/char %6.2f events/char %6.2f frames/char %8.3f us/char\n", name,
+        (double)(after->num_writes - before.num_writes) / NUM_CHARACTERS,
+        (double)(after->num_events - before.num_events) / NUM_CHARACTERS,
+        (double)(after->num_frames - before.num_frames) / NUM_CHARACTERS,
+        elapsed / NUM_CHARACTERS);
+}
+
+
+/**
+ * Main
+ */
+
+int main(void) {
+    if (!bb_uinput_device_init(scancodes, num_scancodes) || !init_unbatched()) {
+        return EXIT_FAILURE;
+    }
+
+    const int plain[] = { KEY_F24 };
+    const int shifted[] = { KEY_LEFTSHIFT, KEY_F24 };
+
+    const bb_uinput_device_stats *batched_stats = bb_uinput_device_get_stats();
+
+    run("unbatched, plain", &unbatched_stats, emit_unbatched, plain, 1);
+    run("unbatched, shifted", &unbatched_stats, emit_unbatched, shifted, 2);
+    run("batched, plain", batched_stats, emit_batched, plain, 1);
+    run("batched, shifted", batched_stats, emit_batched, shifted, 2);
+
+    return EXIT_SUCCESS;
+}
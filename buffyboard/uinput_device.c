@@ -6,20 +6,37 @@
 
 #include "uinput_device.h"
 
+#include <errno.h>
 #include <fcntl.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <linux/uinput.h>
 
 
+/**
+ * Defines
+ */
+
+#define MAX_QUEUED_EVENTS 64
+
+
 /**
  * Static variables
  */
 
 static int fd = -1;
-struct input_event event;
+
+static struct input_event queue[MAX_QUEUED_EVENTS];
+static int num_queued = 0;
+static bool is_frame_open = false;
+
+static struct timeval event_time = { 0 };
+static bool has_event_time = false;
+
+static bb_uinput_device_stats stats = { 0 };
 
 
 /**
@@ -27,42 +44,89 @@ struct input_event event;
  */
 
 /**
- * Emit an event on the device.
+ * Set up the device using the legacy uinput_user_dev interface for kernels older than 4.5.
+ * @param setup device properties
+ * @return true if setting up the device was succesful, false otherwise
+ */
+static bool uinput_device_setup_legacy(const struct uinput_setup *setup);
+
+/**
+ * Append an event to the queue. If the queue is full, it is written to the device first.
  * @param type event type
  * @param code event code
  * @param value event value
- * @return true if emitting the event was succesful, false otherwise
+ * @return true if queueing the event was succesful, false otherwise
  */
-static bool uinput_device_emit(int type, int code, int value);
+static bool uinput_device_queue(int type, int code, int value);
 
 /**
- * Emit a synchronisation event on the device
- * @return true if emitting the event was succesful, false otherwise
+ * Write all queued events to the device with a single syscall.
+ * @return true if writing the events was succesful, false otherwise
  */
-static bool uinput_device_synchronise();
+static bool uinput_device_write_queue(void);
 
 
 /**
  * Static functions
  */
 
-static bool uinput_device_emit(int type, int code, int value) {
-    event.type = type;
-    event.code = code;
-    event.value = value;
-    event.input_event_sec = 0;
-    event.input_event_usec = 0;
+static bool uinput_device_setup_legacy(const struct uinput_setup *setup) {
+    struct uinput_user_dev device;
+    memset(&device, 0, sizeof(device));
+    memcpy(device.name, setup->name, sizeof(device.name));
+    device.id = setup->id;
 
-    if (write(fd, &event, sizeof(event)) != sizeof(event)) {
-        perror("Could not emit event");
+    if (write(fd, &device, sizeof(device)) != sizeof(device)) {
+        perror("Could not set up uinput device");
         return false;
     }
 
     return true;
 }
 
-static bool uinput_device_synchronise() {
-    return uinput_device_emit(EV_SYN, SYN_REPORT, 0);
+static bool uinput_device_queue(int type, int code, int value) {
+    if (num_queued == MAX_QUEUED_EVENTS && !uinput_device_write_queue()) {
+        return false;
+    }
+
+    struct timeval time = event_time;
+    if (!has_event_time) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        time.tv_sec = now.tv_sec;
+        time.tv_usec = now.tv_nsec / 1000;
+    }
+
+    struct input_event *event = &queue[num_queued++];
+    memset(event, 0, sizeof(struct input_event));
+    event->input_event_sec = time.tv_sec;
+    event->input_event_usec = time.tv_usec;
+    event->type = type;
+    event->code = code;
+    event->value = value;
+
+    return true;
+}
+
+static bool uinput_device_write_queue(void) {
+    if (num_queued == 0) {
+        return true;
+    }
+
+    /* uinput accepts any number of events per write, so the whole queue goes out at once */
+    size_t size = num_queued * sizeof(struct input_event);
+    ssize_t written = write(fd, queue, size);
+
+    stats.num_writes++;
+    stats.num_events += num_queued;
+    num_queued = 0;
+
+    if (written < 0 || (size_t)written != size) {
+        perror("Could not emit events");
+        return false;
+    }
+
+    return true;
 }
 
 
@@ -94,33 +158,65 @@ bool bb_uinput_device_init(const int * const scancodes, int num_scancodes) {
         }
     }
 
-    struct uinput_user_dev device;
-	memset(&device, 0, sizeof(device));
-    strcpy(device.name, "buffyboard");
-	device.id.bustype = BUS_USB;
-	device.id.vendor = 1;
-	device.id.product = 1;
-	device.id.version = 1;
-
-	if (ioctl(fd, UI_DEV_SETUP, &device) < 0) {
-		perror("Could not set up uinput device");
-		return false;
-	}
+    struct uinput_setup setup;
+    memset(&setup, 0, sizeof(setup));
+    strcpy(setup.name, "buffyboard");
+    setup.id.bustype = BUS_USB;
+    setup.id.vendor = 1;
+    setup.id.product = 1;
+    setup.id.version = 1;
+
+    /* The device only has keys, so no axes need to be configured with UI_ABS_SETUP */
+    if (ioctl(fd, UI_DEV_SETUP, &setup) < 0) {
+        if (errno != EINVAL && errno != ENOTTY) {
+            perror("Could not set up uinput device");
+            return false;
+        }
+        if (!uinput_device_setup_legacy(&setup)) {
+            return false;
+        }
+    }
 
 	if (ioctl(fd, UI_DEV_CREATE) < 0) {
 		perror("Could not create uinput device");
 		return false;
 	}
 
-    memset(&event, 0, sizeof(event));
-
     return true;
 }
 
-bool bb_uinput_device_emit_key_down(int scancode) {
-    return uinput_device_emit(EV_KEY, scancode, 1) && uinput_device_synchronise();
+void bb_uinput_device_set_event_time(const struct timeval *time) {
+    has_event_time = time != NULL;
+    if (time) {
+        event_time = *time;
+    }
+}
+
+bool bb_uinput_device_queue_key_down(int scancode) {
+    is_frame_open = true;
+    return uinput_device_queue(EV_KEY, scancode, 1);
+}
+
+bool bb_uinput_device_queue_key_up(int scancode) {
+    is_frame_open = true;
+    return uinput_device_queue(EV_KEY, scancode, 0);
+}
+
+bool bb_uinput_device_synchronise(void) {
+    if (!is_frame_open) {
+        return true;
+    }
+
+    is_frame_open = false;
+    stats.num_frames++;
+    return uinput_device_queue(EV_SYN, SYN_REPORT, 0);
+}
+
+bool bb_uinput_device_flush(void) {
+    bool result = bb_uinput_device_synchronise();
+    return uinput_device_write_queue() && result;
 }
 
-bool bb_uinput_device_emit_key_up(int scancode) {
-    return uinput_device_emit(EV_KEY, scancode, 0) && uinput_device_synchronise();
+const bb_uinput_device_stats *bb_uinput_device_get_stats(void) {
+    return &stats;
 }
@@ -9,6 +9,20 @@
 
 #include <stdbool.h>
 
+#include <sys/time.h>
+
+/**
+ * Counters for events written to the uinput device
+ */
+typedef struct {
+    /* Number of events written, including synchronisation events */
+    unsigned long num_events;
+    /* Number of synchronisation frames */
+    unsigned long num_frames;
+    /* Number of write syscalls */
+    unsigned long num_writes;
+} bb_uinput_device_stats;
+
 /**
  * Initialise the uinput keyboard device
  * 
@@ -19,19 +33,52 @@
 bool bb_uinput_device_init(const int * const scancodes, int num_scancodes);
 
 /**
- * Emit a key down event
- * 
+ * Set the CLOCK_MONOTONIC timestamp for subsequently queued events, e.g. the time at which
+ * the corresponding key was pressed on the screen. Note that the kernel may replace the
+ * timestamp with its own when delivering the events.
+ *
+ * @param time timestamp or NULL to stamp events with the time at which they are queued
+ */
+void bb_uinput_device_set_event_time(const struct timeval *time);
+
+/**
+ * Queue a key down event. Queued events are only written to the device when calling
+ * bb_uinput_device_flush.
+ *
  * @param scancode the key's scancode
- * @return true if emitting the event was successful, false otherwise
+ * @return true if queueing the event was successful, false otherwise
  */
-bool bb_uinput_device_emit_key_down(int scancode);
+bool bb_uinput_device_queue_key_down(int scancode);
 
 /**
- * Emit a key up event
- * 
+ * Queue a key up event. Queued events are only written to the device when calling
+ * bb_uinput_device_flush.
+ *
  * @param scancode the key's scancode
- * @return true if emitting the event was successful, false otherwise
+ * @return true if queueing the event was successful, false otherwise
+ */
+bool bb_uinput_device_queue_key_up(int scancode);
+
+/**
+ * Terminate the current frame of queued key events with a synchronisation event. Does
+ * nothing if no key events were queued since the last synchronisation.
+ *
+ * @return true if queueing the event was successful, false otherwise
+ */
+bool bb_uinput_device_synchronise(void);
+
+/**
+ * Terminate the current frame and write all queued events to the device with a single syscall.
+ *
+ * @return true if writing the events was successful, false otherwise
+ */
+bool bb_uinput_device_flush(void);
+
+/**
+ * Get the device's event counters.
+ *
+ * @return pointer to the counters
  */
-bool bb_uinput_device_emit_key_up(int scancode);
+const bb_uinput_device_stats *bb_uinput_device_get_stats(void);
 
 #endif /* BB_UINPUT_DEVICE_H */
@@ -0,0 +1,220 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#include "display.h"
+
+#include "log.h"
+
+#include "lvgl/src/display/lv_display_private.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <linux/fb.h>
+
+#include <sys/ioctl.h>
+
+
+/**
+ * Defines
+ */
+
+/* posix_memalign requires a multiple of the pointer size */
+#define RENDER_BUFFER_ALIGN LV_MAX(LV_DRAW_BUF_ALIGN, sizeof(void *))
+
+
+/**
+ * Static variables
+ */
+
+static const struct {
+    const char *name;
+    lv_display_render_mode_t mode;
+} render_modes[] = {
+    { "partial", LV_DISPLAY_RENDER_MODE_PARTIAL },
+    { "direct", LV_DISPLAY_RENDER_MODE_DIRECT },
+    { "full", LV_DISPLAY_RENDER_MODE_FULL }
+};
+
+static lv_display_flush_cb_t original_flush_cb = NULL;
+
+static void *render_buffer = NULL;
+static uint32_t render_stride = 0;
+static bool is_flushing_rows = false;
+
+static uint32_t frame_bytes = 0;
+static uint32_t frame_areas = 0;
+static lv_area_t frame_bounds;
+
+static int fbdev_fd = -1;
+static struct fb_var_screeninfo fbdev_vinfo;
+
+
+/**
+ * Static prototypes
+ */
+
+/**
+ * Flush callback that accounts for the flushed area before handing it to the original callback.
+ *
+ * @param disp display being flushed
+ * @param area area being flushed
+ * @param px_map rendered pixels for the area
+ */
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
+
+/**
+ * Hand an area of a screen-sized render buffer to the original flush callback one row at a time.
+ *
+ * @param disp display being flushed
+ * @param area area being flushed
+ * @param px_map start of the render buffer
+ * @param px_size size of a pixel in bytes
+ */
+static void flush_rows(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map, uint32_t px_size);
+
+/**
+ * Finish the current frame by refreshing the framebuffer if needed and logging its statistics.
+ */
+static void finish_frame(void);
+
+
+/**
+ * Static functions
+ */
+
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    /* Query before flushing because the flag might be reset once the flush is ready */
+    bool is_last = lv_display_flush_is_last(disp);
+
+    uint32_t px_size = lv_color_format_get_size(lv_display_get_color_format(disp));
+    frame_bytes += lv_area_get_size(area) * px_size;
+    if (frame_areas++ == 0) {
+        lv_area_copy(&frame_bounds, area);
+    } else {
+        _lv_area_join(&frame_bounds, &frame_bounds, area);
+    }
+
+    if (is_flushing_rows) {
+        flush_rows(disp, area, px_map, px_size);
+    } else {
+        original_flush_cb(disp, area, px_map);
+    }
+
+    if (is_last) {
+        finish_frame();
+    }
+}
+
+static void flush_rows(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map, uint32_t px_size) {
+    lv_area_t row;
+    lv_area_copy(&row, area);
+
+    uint8_t *row_map = px_map + area->y1 * render_stride + area->x1 * px_size;
+    for (int32_t y = area->y1; y <= area->y2; ++y) {
+        row.y1 = y;
+        row.y2 = y;
+        original_flush_cb(disp, &row, row_map);
+        row_map += render_stride;
+    }
+}
+
+static void finish_frame(void) {
+    if (fbdev_fd >= 0) {
+        fbdev_vinfo.activate |= FB_ACTIVATE_NOW | FB_ACTIVATE_FORCE;
+        if (ioctl(fbdev_fd, FBIOPUT_VSCREENINFO, &fbdev_vinfo) < 0) {
+            bbx_log(BBX_LOG_LEVEL_WARNING, "Could not force framebuffer refresh: %s", strerror(errno));
+        }
+    }
+
+    bbx_log(BBX_LOG_LEVEL_VERBOSE, "Flushed %u bytes in %u area(s) within %dx%d at (%d, %d)",
+        frame_bytes, frame_areas, lv_area_get_width(&frame_bounds), lv_area_get_height(&frame_bounds),
+        frame_bounds.x1, frame_bounds.y1);
+
+    frame_bytes = 0;
+    frame_areas = 0;
+}
+
+
+/**
+ * Public functions
+ */
+
+void bbx_display_track_flushes(lv_display_t *disp) {
+    if (disp->flush_cb == flush_cb) {
+        return;
+    }
+
+    original_flush_cb = disp->flush_cb;
+    lv_display_set_flush_cb(disp, flush_cb);
+}
+
+bool bbx_display_set_render_buffers(lv_display_t *disp, lv_display_render_mode_t mode, uint32_t buffer_lines) {
+    int32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    int32_t ver_res = lv_display_get_vertical_resolution(disp);
+    uint32_t stride = lv_draw_buf_width_to_stride(hor_res, lv_display_get_color_format(disp));
+
+    uint32_t lines = ver_res;
+    if (mode == LV_DISPLAY_RENDER_MODE_PARTIAL && buffer_lines > 0) {
+        lines = LV_MIN(buffer_lines, (uint32_t)ver_res);
+    }
+    size_t size = (size_t)stride * lines;
+
+    /* Allocate outside of LVGL's heap which is too small for anything but tiny buffers */
+    void *buffer = NULL;
+    int ret = posix_memalign(&buffer, RENDER_BUFFER_ALIGN, size);
+    if (ret != 0) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Could not allocate %zu byte render buffer: %s", size, strerror(ret));
+        return false;
+    }
+
+    lv_display_set_buffers(disp, buffer, NULL, size, mode);
+    free(render_buffer);
+    render_buffer = buffer;
+    render_stride = stride;
+
+    /* The framebuffer driver expects the pixels of an area to be contiguous which only holds for
+     * single rows of a screen-sized buffer in direct mode */
+    is_flushing_rows = (mode == LV_DISPLAY_RENDER_MODE_DIRECT);
+    bbx_display_track_flushes(disp);
+
+    bbx_log(BBX_LOG_LEVEL_VERBOSE, "Rendering %u of %d lines at a time into a %zu byte buffer", lines, ver_res, size);
+
+    return true;
+}
+
+bool bbx_display_find_render_mode_with_name(const char *name, lv_display_render_mode_t *mode) {
+    for (size_t i = 0; i < sizeof(render_modes) / sizeof(render_modes[0]); ++i) {
+        if (strcmp(render_modes[i].name, name) == 0) {
+            *mode = render_modes[i].mode;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool bbx_display_set_fbdev_force_refresh(lv_display_t *disp, const char *path) {
+    if (fbdev_fd < 0) {
+        fbdev_fd = open(path, O_RDWR | O_CLOEXEC);
+        if (fbdev_fd < 0) {
+            bbx_log(BBX_LOG_LEVEL_WARNING, "Could not open %s for forced refreshes: %s", path, strerror(errno));
+            return false;
+        }
+
+        if (ioctl(fbdev_fd, FBIOGET_VSCREENINFO, &fbdev_vinfo) < 0) {
+            bbx_log(BBX_LOG_LEVEL_WARNING, "Could not query %s for forced refreshes: %s", path, strerror(errno));
+            close(fbdev_fd);
+            fbdev_fd = -1;
+            return false;
+        }
+    }
+
+    bbx_display_track_flushes(disp);
+    return true;
+}
@@ -0,0 +1,60 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#ifndef BBX_DISPLAY_H
+#define BBX_DISPLAY_H
+
+#include "lvgl/lvgl.h"
+
+#include <stdbool.h>
+
+/**
+ * Wrap a display's flush callback to account for the flushed areas. In verbose mode, the number of
+ * flushed bytes and areas is logged once per frame. Must be called after the display driver has
+ * set its flush callback. Only a single display can be tracked.
+ *
+ * @param disp display to track
+ */
+void bbx_display_track_flushes(lv_display_t *disp);
+
+/**
+ * Replace a display's render buffers with a buffer allocated outside of LVGL's heap and aligned
+ * for drawing. In partial mode, the buffer holds buffer_lines rows so that regions up to this
+ * height are rendered and flushed in a single pass. In direct and full mode, it holds the entire
+ * screen. Flushes are tracked like with bbx_display_track_flushes to allow tuning the buffer size
+ * against frame time. Must be called after the display's resolution was set up.
+ *
+ * The buffer that the framebuffer driver allocated initially is owned by the driver and cannot be
+ * freed here. LV_LINUX_FBDEV_BUFFER_SIZE is therefore set to a single row in lv_conf.h. Like the
+ * flush tracking, the render buffers only support a single display.
+ *
+ * @param disp display whose flush callback copies areas into the framebuffer
+ * @param mode render mode
+ * @param buffer_lines number of rows to buffer in partial mode, 0 for the entire screen
+ * @return true if the buffers were replaced, false otherwise
+ */
+bool bbx_display_set_render_buffers(lv_display_t *disp, lv_display_render_mode_t mode, uint32_t buffer_lines);
+
+/**
+ * Find the render mode with a given name.
+ *
+ * @param name render mode name (partial, direct or full)
+ * @param mode pointer to write the render mode into if a mode matched
+ * @return true if a render mode matched, false otherwise
+ */
+bool bbx_display_find_render_mode_with_name(const char *name, lv_display_render_mode_t *mode);
+
+/**
+ * Force the framebuffer to be refreshed once after the last area of every frame was flushed. This
+ * is a replacement for lv_linux_fbdev_set_force_refresh which refreshes after every single area.
+ *
+ * @param disp display backed by the framebuffer
+ * @param path path of the framebuffer device (e.g. /dev/fb0)
+ * @return true if forced refreshes were enabled, false otherwise
+ */
+bool bbx_display_set_fbdev_force_refresh(lv_display_t *disp, const char *path);
+
+#endif /* BBX_DISPLAY_H */
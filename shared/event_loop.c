@@ -0,0 +1,288 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#include "event_loop.h"
+
+#include "log.h"
+#include "tick.h"
+
+#include "lvgl/lvgl.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+
+
+/**
+ * Defines
+ */
+
+#define MAX_EVENTS 16
+#define STATS_WINDOW_US (10 * 1000 * 1000)
+
+
+/**
+ * Static variables
+ */
+
+struct watch {
+    int fd;
+    bbx_event_loop_fd_cb cb;
+    void *user_data;
+    bool removed;
+    struct watch *next;
+};
+
+static int epoll_fd = -1;
+static struct watch *watches = NULL;
+static bool has_removed_watches = false;
+
+static int signal_fd = -1;
+static bbx_event_loop_signal_cb signal_cb = NULL;
+
+static uint64_t stats_window_start_us = 0;
+static uint64_t stats_idle_us = 0;
+static uint32_t stats_wakeups = 0;
+
+
+/**
+ * Static prototypes
+ */
+
+/**
+ * Find the watch for a file descriptor.
+ *
+ * @param fd file descriptor
+ * @return the watch or NULL if the file descriptor isn't watched
+ */
+static struct watch *find_watch(int fd);
+
+/**
+ * Free watches that were removed while dispatching events.
+ */
+static void free_removed_watches(void);
+
+/**
+ * Read pending signals from the signal file descriptor and pass them on to the signal callback.
+ *
+ * @param fd signal file descriptor
+ * @param events mask of epoll events that occurred
+ * @param user_data unused
+ */
+static void signal_fd_ready_cb(int fd, uint32_t events, void *user_data);
+
+/**
+ * Account for a wakeup and log idle statistics once per stats window.
+ *
+ * @param sleep_start_us time at which the loop started sleeping
+ * @param sleep_end_us time at which the loop woke up
+ */
+static void update_stats(uint64_t sleep_start_us, uint64_t sleep_end_us);
+
+
+/**
+ * Static functions
+ */
+
+static struct watch *find_watch(int fd) {
+    for (struct watch *watch = watches; watch; watch = watch->next) {
+        if (watch->fd == fd && !watch->removed) {
+            return watch;
+        }
+    }
+    return NULL;
+}
+
+static void free_removed_watches(void) {
+    if (!has_removed_watches) {
+        return;
+    }
+
+    struct watch **link = &watches;
+    while (*link) {
+        struct watch *watch = *link;
+        if (watch->removed) {
+            *link = watch->next;
+            free(watch);
+        } else {
+            link = &watch->next;
+        }
+    }
+
+    has_removed_watches = false;
+}
+
+static void signal_fd_ready_cb(int fd, uint32_t events, void *user_data) {
+    LV_UNUSED(events);
+    LV_UNUSED(user_data);
+
+    struct signalfd_siginfo info;
+    while (read(fd, &info, sizeof(info)) == sizeof(info)) {
+        if (signal_cb) {
+            signal_cb(info.ssi_signo);
+        }
+    }
+}
+
+static void update_stats(uint64_t sleep_start_us, uint64_t sleep_end_us) {
+    stats_idle_us += sleep_end_us - sleep_start_us;
+    ++stats_wakeups;
+
+    uint64_t elapsed_us = sleep_end_us - stats_window_start_us;
+    if (elapsed_us < STATS_WINDOW_US) {
+        return;
+    }
+
+    bbx_log(BBX_LOG_LEVEL_VERBOSE, "Event loop: %.1f%% idle, %.1f wakeups/s",
+        100.0 * stats_idle_us / elapsed_us, 1000000.0 * stats_wakeups / elapsed_us);
+
+    stats_window_start_us = sleep_end_us;
+    stats_idle_us = 0;
+    stats_wakeups = 0;
+}
+
+
+/**
+ * Public functions
+ */
+
+bool bbx_event_loop_init(void) {
+    if (epoll_fd >= 0) {
+        return true;
+    }
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not create epoll instance: %s", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+bool bbx_event_loop_add_fd(int fd, uint32_t events, bbx_event_loop_fd_cb cb, void *user_data) {
+    if (epoll_fd < 0) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Cannot watch file descriptor %d because the event loop is not initialised", fd);
+        return false;
+    }
+
+    if (find_watch(fd)) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Ignoring already watched file descriptor %d", fd);
+        return false;
+    }
+
+    struct watch *watch = malloc(sizeof(struct watch));
+    if (!watch) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not allocate memory for file descriptor watch");
+        return false;
+    }
+    watch->fd = fd;
+    watch->cb = cb;
+    watch->user_data = user_data;
+    watch->removed = false;
+
+    struct epoll_event event = { .events = events, .data.ptr = watch };
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Could not watch file descriptor %d: %s", fd, strerror(errno));
+        free(watch);
+        return false;
+    }
+
+    watch->next = watches;
+    watches = watch;
+
+    return true;
+}
+
+void bbx_event_loop_remove_fd(int fd) {
+    struct watch *watch = find_watch(fd);
+    if (!watch) {
+        return;
+    }
+
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+
+    /* Defer freeing because the watch might still be referenced by pending events */
+    watch->removed = true;
+    has_removed_watches = true;
+}
+
+bool bbx_event_loop_handle_signals(const int *signums, int num_signums, bbx_event_loop_signal_cb cb) {
+    sigset_t mask;
+    sigemptyset(&mask);
+    for (int i = 0; i < num_signums; ++i) {
+        sigaddset(&mask, signums[i]);
+    }
+
+    if (sigprocmask(SIG_BLOCK, &mask, NULL) < 0) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not block signals: %s", strerror(errno));
+        return false;
+    }
+
+    signal_fd = signalfd(signal_fd, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (signal_fd < 0) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not create signal file descriptor: %s", strerror(errno));
+        sigprocmask(SIG_UNBLOCK, &mask, NULL);
+        return false;
+    }
+
+    signal_cb = cb;
+
+    if (!find_watch(signal_fd) && !bbx_event_loop_add_fd(signal_fd, EPOLLIN, signal_fd_ready_cb, NULL)) {
+        sigprocmask(SIG_UNBLOCK, &mask, NULL);
+        return false;
+    }
+
+    return true;
+}
+
+void bbx_event_loop_run(void) {
+    struct epoll_event events[MAX_EVENTS];
+
+    /* Without an epoll instance, fall back to sleeping until the next timer is due */
+    if (epoll_fd < 0) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Event loop is not initialised, only running timers");
+        while (1) {
+            uint32_t time_till_next = lv_timer_handler();
+            usleep(LV_MIN(time_till_next, LV_DEF_REFR_PERIOD) * 1000);
+        }
+    }
+
+    stats_window_start_us = bbx_tick_get_us();
+
+    while (1) {
+        /* Run due timers and figure out how long we can sleep */
+        uint32_t time_till_next = lv_timer_handler();
+        int timeout = time_till_next == LV_NO_TIMER_READY ? -1 : (int)time_till_next;
+
+        /* Sleep until the next timer is due or a file descriptor becomes ready */
+        uint64_t sleep_start_us = bbx_tick_get_us();
+        int num_events = epoll_wait(epoll_fd, events, MAX_EVENTS, timeout);
+        update_stats(sleep_start_us, bbx_tick_get_us());
+
+        if (num_events < 0) {
+            if (errno != EINTR) {
+                bbx_log(BBX_LOG_LEVEL_ERROR, "Could not wait for events: %s", strerror(errno));
+            }
+            continue;
+        }
+
+        /* Dispatch events */
+        for (int i = 0; i < num_events; ++i) {
+            struct watch *watch = events[i].data.ptr;
+            if (!watch->removed) {
+                watch->cb(watch->fd, events[i].events, watch->user_data);
+            }
+        }
+
+        free_removed_watches();
+    }
+}
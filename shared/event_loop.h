@@ -0,0 +1,72 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#ifndef BBX_EVENT_LOOP_H
+#define BBX_EVENT_LOOP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Callback for file descriptors that became ready.
+ *
+ * @param fd the file descriptor
+ * @param events mask of epoll events that occurred
+ * @param user_data user data supplied when the file descriptor was added
+ */
+typedef void (*bbx_event_loop_fd_cb)(int fd, uint32_t events, void *user_data);
+
+/**
+ * Callback for signals delivered to the process.
+ *
+ * @param signum the signal's number
+ */
+typedef void (*bbx_event_loop_signal_cb)(int signum);
+
+/**
+ * Initialise the event loop. Needs to be called before any other event loop function.
+ *
+ * @return true if the event loop was initialised successfully, false otherwise
+ */
+bool bbx_event_loop_init(void);
+
+/**
+ * Add a file descriptor to the event loop. The callback is invoked on the main thread whenever
+ * the file descriptor becomes ready.
+ *
+ * @param fd file descriptor to watch
+ * @param events mask of epoll events to watch for (e.g. EPOLLIN)
+ * @param cb callback to invoke when the file descriptor becomes ready
+ * @param user_data user data to pass to the callback
+ * @return true if the file descriptor was added successfully, false otherwise
+ */
+bool bbx_event_loop_add_fd(int fd, uint32_t events, bbx_event_loop_fd_cb cb, void *user_data);
+
+/**
+ * Remove a previously added file descriptor from the event loop. The file descriptor is not closed.
+ *
+ * @param fd file descriptor to remove
+ */
+void bbx_event_loop_remove_fd(int fd);
+
+/**
+ * Block the specified signals and deliver them through the event loop instead. Must be called
+ * before any additional threads are spawned so that they inherit the signal mask.
+ *
+ * @param signums array of signal numbers
+ * @param num_signums number of items in signums
+ * @param cb callback to invoke when one of the signals is received
+ * @return true if the signals are handled by the event loop, false otherwise
+ */
+bool bbx_event_loop_handle_signals(const int *signums, int num_signums, bbx_event_loop_signal_cb cb);
+
+/**
+ * Run the event loop. Sleeps until the next LVGL timer is due or one of the added file descriptors
+ * becomes ready. Never returns.
+ */
+void bbx_event_loop_run(void);
+
+#endif /* BBX_EVENT_LOOP_H */
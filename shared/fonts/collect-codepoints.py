@@ -0,0 +1,231 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 Johannes Marbach
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+
+import argparse
+import os
+import re
+import sys
+
+
+###
+# Global constants
+
+fonts_dir = os.path.dirname(os.path.abspath(__file__))
+repository_dir = os.path.normpath(os.path.join(fonts_dir, '..', '..'))
+
+# Generated layouts whose keycaps, names and short names are shown on screen
+layout_sources = [
+    'unl0kr/sq2lv_layouts.c',
+    'buffyboard/sq2lv_layouts.c'
+]
+
+# Sources whose string literals are shown on screen
+ui_sources = [
+    'unl0kr/main.c'
+]
+
+# Sources and headers scanned for LV_SYMBOL_* and UL_SYMBOL_* references
+symbol_source_dirs = [
+    'buffyboard',
+    'shared',
+    'unl0kr'
+]
+
+# Headers defining symbol constants
+symbol_headers = [
+    'lvgl/src/font/lv_symbol_def.h',
+    'unl0kr/unl0kr.h'
+]
+
+# Symbols used internally by LVGL widgets that BuffyBox shows (dropdown arrows)
+implicit_symbols = [
+    'LV_SYMBOL_DOWN',
+    'LV_SYMBOL_UP'
+]
+
+# Characters needed for password entry with a hardware keyboard
+printable_ascii = range(0x20, 0x7F)
+
+# Code points available in the text font, needs to be kept in sync with regenerate.sh
+text_font_ranges = [
+    (0x0020, 0x007F),
+    (0x00A0, 0x00FF),
+    (0x0100, 0x017F),
+    (0x0370, 0x03FF),
+    (0x2000, 0x206F),
+    (0x20A0, 0x20CF),
+    (0x2200, 0x22FF)
+]
+
+# Private use area where the symbol font's pictograms live
+symbol_font_range = (0xE000, 0xF8FF)
+
+
+###
+# General helpers
+##
+
+def die(msg):
+    """Print an error message to STDERR and exit with a non-zero code.
+
+    msg -- message to output on STDERR
+    """
+    sys.stderr.write(msg if msg.endswith('\n') else msg + '\n')
+    sys.exit(1)
+
+
+def warn(msg):
+    """Print a warning message to STDERR.
+
+    msg -- message to output on STDERR
+    """
+    sys.stderr.write(msg if msg.endswith('\n') else msg + '\n')
+
+
+def parse_arguments():
+    """ Parse commandline arguments.
+    """
+    parser = argparse.ArgumentParser(description='Collect the code points that BuffyBox displays and print them as '
+                                     + 'lv_font_conv range.')
+    parser.add_argument('--font', dest='font', choices=['text', 'symbols'], required=True, help='font to print the '
+                        + 'range for.')
+    return parser.parse_args()
+
+
+def read_source(rel_path):
+    """Return the contents of a file in the repository.
+
+    rel_path -- file path relative to the repository root
+    """
+    path = os.path.join(repository_dir, rel_path)
+    if not os.path.isfile(path):
+        die(f'Could not find {path}')
+    with open(path, 'r', encoding='utf-8') as fp:
+        return fp.read()
+
+
+###
+# C parsing
+##
+
+def c_string_literals(source):
+    """Return the decoded values of all string literals in a C source.
+
+    source -- C source code
+    """
+    source = re.sub(r'/\*.*?\*/', '', source, flags=re.DOTALL)
+    source = re.sub(r'//[^\n]*', '', source)
+    return [decode_c_string(m.group(1)) for m in re.finditer(r'"((?:[^"\\\n]|\\.)*)"', source)]
+
+
+def decode_c_string(literal):
+    """Return the string value of the contents of a UTF-8 encoded C string literal.
+
+    literal -- literal contents without the surrounding quotes
+    """
+    escapes = { 'n': b'\n', 't': b'\t', 'r': b'\r', '0': b'\0', '\\': b'\\', '"': b'"', '\'': b'\'' }
+    value = bytearray()
+    i = 0
+    while i < len(literal):
+        if literal[i] != '\\':
+            value += literal[i].encode('utf-8')
+            i += 1
+        elif literal[i + 1] in 'xX':
+            match = re.match(r'[0-9a-fA-F]{1,2}', literal[i + 2:])
+            value.append(int(match.group(0), 16))
+            i += 2 + len(match.group(0))
+        else:
+            value += escapes.get(literal[i + 1], literal[i + 1].encode('utf-8'))
+            i += 2
+    return value.decode('utf-8', errors='replace')
+
+
+def symbol_definitions():
+    """Return a dictionary mapping symbol constants to their values.
+    """
+    definitions = {}
+    for header in symbol_headers:
+        for match in re.finditer(r'#define\s+((?:LV|UL)_SYMBOL_\w+)\s+"([^"]*)"', read_source(header)):
+            definitions[match.group(1)] = decode_c_string(match.group(2))
+    return definitions
+
+
+def used_symbols():
+    """Return the names of all symbol constants referenced in BuffyBox's sources.
+    """
+    symbols = set(implicit_symbols)
+    for rel_dir in symbol_source_dirs:
+        for root, _, files in os.walk(os.path.join(repository_dir, rel_dir)):
+            for file in files:
+                if not file.endswith('.c') and not file.endswith('.h'):
+                    continue
+                with open(os.path.join(root, file), 'r', encoding='utf-8') as fp:
+                    symbols.update(re.findall(r'\b(?:LV|UL)_SYMBOL_\w+', fp.read()))
+    return symbols
+
+
+###
+# Code point processing
+##
+
+def collect_code_points():
+    """Return the set of all code points that BuffyBox displays.
+    """
+    code_points = set(printable_ascii)
+
+    for rel_path in layout_sources + ui_sources:
+        for literal in c_string_literals(read_source(rel_path)):
+            code_points.update(ord(c) for c in literal)
+
+    definitions = symbol_definitions()
+    for symbol in used_symbols():
+        if symbol not in definitions:
+            die(f'Could not find definition of {symbol}')
+        code_points.update(ord(c) for c in definitions[symbol])
+
+    return set(c for c in code_points if c >= 0x20 and c != 0x7F)
+
+
+def is_in_text_font(code_point):
+    """Return True if a code point is included in the text font.
+
+    code_point -- code point to check
+    """
+    return any(start <= code_point <= end for start, end in text_font_ranges)
+
+
+def to_range(code_points):
+    """Return an lv_font_conv range for a set of code points, merging consecutive code points.
+
+    code_points -- code points to include
+    """
+    ranges = []
+    for code_point in sorted(code_points):
+        if ranges and ranges[-1][1] == code_point - 1:
+            ranges[-1][1] = code_point
+        else:
+            ranges.append([code_point, code_point])
+    return ','.join(f'0x{start:04X}' if start == end else f'0x{start:04X}-0x{end:04X}' for start, end in ranges)
+
+
+###
+# Main
+##
+
+if __name__ == '__main__':
+    args = parse_arguments()
+
+    code_points = collect_code_points()
+    symbol_code_points = set(c for c in code_points if symbol_font_range[0] <= c <= symbol_font_range[1])
+    text_code_points = code_points - symbol_code_points
+
+    if args.font == 'text':
+        for code_point in sorted(text_code_points):
+            if not is_in_text_font(code_point):
+                warn(f'Skipping U+{code_point:04X} which is not covered by the text font ranges')
+        print(to_range(set(c for c in text_code_points if is_in_text_font(c))))
+    else:
+        print(to_range(symbol_code_points))
@@ -7,19 +7,30 @@
 #include "indev.h"
 
 #include "cursor/cursor.h"
+#include "event_loop.h"
 #include "log.h"
+#include "replay.h"
+#include "tick.h"
 
+#include "lvgl/src/display/lv_display_private.h"
 #include "lvgl/src/indev/lv_indev_private.h"
 
+#include <errno.h>
+#include <fcntl.h>
 #include <libinput.h>
 #include <libudev.h>
 #include <limits.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
 
 #include <linux/input.h>
 
-#include <sys/select.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/sysmacros.h>
 
 
 /**
@@ -32,6 +43,16 @@
 #define MAX_POINTER_DEVS 4
 #define MAX_TOUCHSCREEN_DEVS 1
 
+#define DEVICE_IDLE_TIMEOUT 2000
+
+#define NUM_DEVICE_BUCKETS 32
+#define MAX_QUEUED_EVENTS 32
+#define MAX_PROBE_THREADS 4
+#define READ_STATS_WINDOW_US (10 * 1000 * 1000)
+
+#define HOTPLUG_SETTLE_TIME 50
+#define MONITOR_POLL_PERIOD 1000
+
 
 /**
  * Static variables
@@ -42,20 +63,84 @@ static lv_libinput_capability allowed_capability = LV_LIBINPUT_CAPABILITY_NONE;
 static struct udev *context = NULL;
 static struct udev_monitor *monitor = NULL;
 static int monitor_fd = -1;
+static bool is_monitor_fd_watched = false;
+static lv_timer_t *monitor_timer = NULL;
+static lv_timer_t *hotplug_timer = NULL;
+
+static struct udev_device **pending_devices = NULL;
+static int num_pending_devices = 0;
+static int max_pending_devices = 0;
+
+struct queued_event {
+  lv_point_t point;
+  uint32_t key;
+  lv_indev_state_t state;
+  bool is_motion;
+};
 
 struct input_device {
+  dev_t devnum;
   char *node;
   lv_libinput_capability capability;
   lv_indev_t *indev;
+  struct libinput_device *libinput_device;
+  struct queued_event queue[MAX_QUEUED_EVENTS];
+  int queue_start;
+  int queue_length;
+  bool has_new_events;
+  lv_point_t point;
+  uint32_t key;
+  lv_indev_state_t state;
+  int32_t touch_slot;
+#if LV_LIBINPUT_XKB
+  lv_xkb_t xkb;
+  bool has_xkb;
+#endif /* LV_LIBINPUT_XKB */
+  struct input_device *prev;
+  struct input_device *next;
+  struct input_device *next_in_bucket;
 };
 
-static struct input_device **devices = NULL;
-static int num_devices = 0;
+static struct input_device *device_buckets[NUM_DEVICE_BUCKETS];
+static struct input_device *first_device = NULL;
 static int num_connected_devices = 0;
+static int num_keyboard_devices = 0;
+static int num_pointer_devices = 0;
+static int num_touch_devices = 0;
 
 lv_group_t *keyboard_input_group = NULL;
 lv_obj_t *cursor_obj = NULL;
 
+static struct libinput *libinput_context = NULL;
+static int libinput_fd = -1;
+static bool is_libinput_fd_watched = false;
+static bool is_dispatching = false;
+
+static lv_timer_t *idle_timer = NULL;
+
+struct probe_job {
+  dev_t devnum;
+  char *node;
+  int fd;
+  lv_libinput_capability capability;
+  uint64_t probe_time_us;
+  struct probe_job *next;
+};
+
+static pthread_mutex_t probe_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct probe_job *queued_probes = NULL;
+static struct probe_job *finished_probes = NULL;
+static int probe_event_fd = -1;
+static int num_running_probes = 0;
+static uint64_t probe_start_us = 0;
+static struct probe_job *probe_in_connection = NULL;
+static bbx_indev_auto_connect_finished_cb auto_connect_finished_cb = NULL;
+
+static uint64_t stats_window_start_us = 0;
+static uint64_t stats_read_time_us = 0;
+static uint32_t stats_num_frames = 0;
+static uint32_t stats_num_events = 0;
+
 
 /**
  * Static prototypes
@@ -93,6 +178,32 @@ static bool is_touch_device(struct input_device *device);
  */
 static char *capability_to_str(lv_libinput_capability capability);
 
+/**
+ * Test whether a udev device property is set to "1".
+ *
+ * @param device udev device
+ * @param name property name
+ * @return true if the property is set
+ */
+static bool has_udev_property(struct udev_device *device, const char *name);
+
+/**
+ * Estimate a device's capabilities from the ID_INPUT_* properties set by udev's input_id builtin.
+ * Errs on the side of reporting too many capabilities so that no usable device is skipped.
+ *
+ * @param device udev device
+ * @return estimated capabilities or all capabilities if udev hasn't classified the device
+ */
+static lv_libinput_capability query_udev_capability(struct udev_device *device);
+
+/**
+ * Check whether a udev device refers to a supported device node that can have allowed capabilities.
+ *
+ * @param device udev device
+ * @return true if the device should be connected, false otherwise
+ */
+static bool should_connect_udev_device(struct udev_device *device);
+
 /**
  * Connect a specific input device using its udev device.
  *
@@ -100,26 +211,64 @@ static char *capability_to_str(lv_libinput_capability capability);
  */
 static void connect_udev_device(struct udev_device *device);
 
+/**
+ * Get the registry bucket for a device number.
+ *
+ * @param devnum device number
+ * @return pointer to the head of the bucket's chain
+ */
+static struct input_device **get_bucket(dev_t devnum);
+
+/**
+ * Find a connected input device using its device number.
+ *
+ * @param devnum device number
+ * @return the device or NULL if it isn't connected
+ */
+static struct input_device *find_device(dev_t devnum);
+
+/**
+ * Add an input device to the registry and update the capability counters.
+ *
+ * @param device the input device
+ */
+static void register_device(struct input_device *device);
+
+/**
+ * Remove an input device from the registry and update the capability counters.
+ *
+ * @param device the input device
+ */
+static void unregister_device(struct input_device *device);
+
 /**
  * Connect a specific input device using its device node.
  *
  * @param node device node path
+ * @param devnum device number of the node
  */
-static void connect_devnode(const char *node);
+static void connect_devnode(const char *node, dev_t devnum);
 
 /**
- * Disconnect a specific input device using its device node.
+ * Disconnect a specific input device using its udev device.
  *
- * @param node device node path
+ * @param device udev device
  */
-static void disconnect_devnode(const char *node);
+static void disconnect_udev_device(struct udev_device *device);
 
 /**
- * Disconnect a specific input device using its index in the devices array.
+ * Disconnect a connected input device and free it.
  *
- * @param idx index in devices array
+ * @param device the input device
+ */
+static void disconnect_device(struct input_device *device);
+
+/**
+ * Release an input device's resources. The device must not be registered.
+ *
+ * @param device the input device
  */
-static void disconnect_idx(int idx);
+static void free_device(struct input_device *device);
 
 /**
  * Set up the input group for a keyboard device.
@@ -135,6 +284,164 @@ static void set_keyboard_input_group(struct input_device *device);
  */
 static void set_mouse_cursor(struct input_device *device);
 
+/**
+ * Open a device node on behalf of libinput.
+ *
+ * @param path device node path
+ * @param flags flags for open()
+ * @param user_data unused
+ * @return file descriptor or negative errno on failure
+ */
+static int open_restricted(const char *path, int flags, void *user_data);
+
+/**
+ * Close a device node on behalf of libinput.
+ *
+ * @param fd file descriptor
+ * @param user_data unused
+ */
+static void close_restricted(int fd, void *user_data);
+
+/**
+ * Test whether a bit is set in an evdev bit mask.
+ *
+ * @param bits the bit mask
+ * @param bit index of the bit to test
+ * @return true if the bit is set
+ */
+static bool test_bit(const unsigned long *bits, int bit);
+
+/**
+ * Estimate the capabilities libinput will assign to an evdev device. Errs on the side of
+ * reporting too many capabilities so that no usable device is skipped.
+ *
+ * @param fd file descriptor of the opened device node
+ * @return estimated capabilities
+ */
+static lv_libinput_capability estimate_capability(int fd);
+
+/**
+ * Open and classify a device node.
+ *
+ * @param job the probe job to process
+ */
+static void probe_devnode(struct probe_job *job);
+
+/**
+ * Entry point for probe worker threads. Processes queued probe jobs until the queue is empty.
+ *
+ * @param arg unused
+ * @return NULL
+ */
+static void *probe_thread(void *arg);
+
+/**
+ * Connect the devices of finished probe jobs on the main thread.
+ *
+ * @param fd the probe event file descriptor
+ * @param events mask of epoll events that occurred
+ * @param user_data unused
+ */
+static void probe_event_fd_ready_cb(int fd, uint32_t events, void *user_data);
+
+/**
+ * Probe device nodes on worker threads and connect them on the main thread as results come in.
+ *
+ * @param jobs linked list of probe jobs
+ * @param num_jobs number of jobs in the list
+ * @return true if probing was started, false if the jobs have to be processed synchronously
+ */
+static bool start_probe_threads(struct probe_job *jobs, int num_jobs);
+
+/**
+ * Create the libinput context shared by all input devices if it doesn't exist yet.
+ *
+ * @return true if the context is available, false otherwise
+ */
+static bool init_libinput_context(void);
+
+/**
+ * Translate a libinput event into the input device's event queue.
+ *
+ * @param device the input device
+ * @param event the libinput event
+ */
+static void queue_libinput_event(struct input_device *device, struct libinput_event *event);
+
+/**
+ * Dispatch pending libinput events to the input devices.
+ *
+ * @param read_devices if true, immediately read the input devices that received new events
+ */
+static void dispatch_libinput(bool read_devices);
+
+/**
+ * Read callback for the LVGL input devices.
+ *
+ * @param indev the LVGL input device
+ * @param data pointer for writing the current state into
+ */
+static void read_cb(lv_indev_t *indev, lv_indev_data_t *data);
+
+/**
+ * Handle activity on the libinput file descriptor.
+ *
+ * @param fd the file descriptor
+ * @param events mask of epoll events that occurred
+ * @param user_data unused
+ */
+static void libinput_fd_ready_cb(int fd, uint32_t events, void *user_data);
+
+/**
+ * Account for the time spent reading input devices and log it per frame once per stats window.
+ *
+ * @param event the event object
+ */
+static void refr_ready_cb(lv_event_t *event);
+
+/**
+ * Callback for the idle timer. Pauses the read timers of devices that aren't pressed.
+ *
+ * @param timer the timer object
+ */
+static void idle_timer_cb(lv_timer_t *timer);
+
+/**
+ * Receive all queued udev monitor events without blocking and add them to the pending devices.
+ *
+ * @return number of received events
+ */
+static int receive_monitor_events(void);
+
+/**
+ * (Dis)connect all pending devices in a single pass. When a device node received several
+ * events, only the last one is acted upon.
+ */
+static void process_pending_devices(void);
+
+/**
+ * Handle activity on the udev monitor's file descriptor.
+ *
+ * @param fd the file descriptor
+ * @param events mask of epoll events that occurred
+ * @param user_data unused
+ */
+static void monitor_fd_ready_cb(int fd, uint32_t events, void *user_data);
+
+/**
+ * Callback for the hotplug timer. Processes pending devices once a burst of events has settled.
+ *
+ * @param timer the timer object
+ */
+static void hotplug_timer_cb(lv_timer_t *timer);
+
+/**
+ * Callback for the monitor timer. Polls the udev monitor if its file descriptor can't be watched.
+ *
+ * @param timer the timer object
+ */
+static void query_device_monitor(lv_timer_t *timer);
+
 
 /**
  * Static functions
@@ -165,76 +472,173 @@ static char *capability_to_str(lv_libinput_capability capability) {
     return "none";
 }
 
-static void connect_udev_device(struct udev_device *device) {
+static bool has_udev_property(struct udev_device *device, const char *name) {
+    const char *value = udev_device_get_property_value(device, name);
+    return value && strcmp(value, "1") == 0;
+}
+
+static lv_libinput_capability query_udev_capability(struct udev_device *device) {
+    /* Without udev rules (e.g. in a minimal initramfs) devices aren't classified */
+    if (!has_udev_property(device, "ID_INPUT")) {
+        return LV_LIBINPUT_CAPABILITY_KEYBOARD | LV_LIBINPUT_CAPABILITY_POINTER | LV_LIBINPUT_CAPABILITY_TOUCH;
+    }
+
+    lv_libinput_capability capability = LV_LIBINPUT_CAPABILITY_NONE;
+
+    /* libinput considers any device with keys a keyboard, including power and volume buttons */
+    if (has_udev_property(device, "ID_INPUT_KEYBOARD") || has_udev_property(device, "ID_INPUT_KEY")) {
+        capability |= LV_LIBINPUT_CAPABILITY_KEYBOARD;
+    }
+
+    if (has_udev_property(device, "ID_INPUT_MOUSE") || has_udev_property(device, "ID_INPUT_POINTINGSTICK")
+            || has_udev_property(device, "ID_INPUT_TOUCHPAD") || has_udev_property(device, "ID_INPUT_TABLET")) {
+        capability |= LV_LIBINPUT_CAPABILITY_POINTER;
+    }
+
+    if (has_udev_property(device, "ID_INPUT_TOUCHSCREEN")) {
+        capability |= LV_LIBINPUT_CAPABILITY_TOUCH;
+    }
+
+    return capability;
+}
+
+static bool should_connect_udev_device(struct udev_device *device) {
     /* Obtain and verify device node */
     const char *node = udev_device_get_devnode(device);
     if (!node || strncmp(node, INPUT_DEVICE_NODE_PREFIX, strlen(INPUT_DEVICE_NODE_PREFIX)) != 0) {
         bbx_log(BBX_LOG_LEVEL_VERBOSE, "Ignoring unsupported input device %s", udev_device_get_syspath(device));
+        return false;
+    }
+
+    /* Avoid opening devices that can't match (e.g. buttons and sensors when keyboards aren't allowed) */
+    lv_libinput_capability capability = query_udev_capability(device);
+    if ((capability & allowed_capability) == LV_LIBINPUT_CAPABILITY_NONE) {
+        bbx_log(BBX_LOG_LEVEL_VERBOSE, "Ignoring input device %s because udev reports no allowed capabilities (%s)",
+            node, capability_to_str(capability));
+        return false;
+    }
+
+    return true;
+}
+
+static void connect_udev_device(struct udev_device *device) {
+    if (!should_connect_udev_device(device)) {
         return;
     }
 
     /* Connect device using its node */
-    connect_devnode(node);
+    connect_devnode(udev_device_get_devnode(device), udev_device_get_devnum(device));
 }
 
-static void connect_devnode(const char *node) {
-    /* Check if the device is already connected */
-    for (int i = 0; i < num_connected_devices; ++i) {
-        if (strcmp(devices[i]->node, node) == 0) {
-            bbx_log(BBX_LOG_LEVEL_WARNING, "Ignoring already connected input device %s", node);
-            return;
+static struct input_device **get_bucket(dev_t devnum) {
+    return &(device_buckets[(major(devnum) * 31 + minor(devnum)) % NUM_DEVICE_BUCKETS]);
+}
+
+static struct input_device *find_device(dev_t devnum) {
+    for (struct input_device *device = *get_bucket(devnum); device; device = device->next_in_bucket) {
+        if (device->devnum == devnum) {
+            return device;
         }
     }
+    return NULL;
+}
 
-    /* Double array size every time it's filled */
-    if (num_connected_devices == num_devices) {
-        /* Re-allocate array */
-        struct input_device **tmp = realloc(devices, (2 * num_devices + 1) * sizeof(struct input_device *));
-        if (!tmp) {
-            bbx_log(BBX_LOG_LEVEL_ERROR, "Could not reallocate memory for input device array");
-            return;
+static void register_device(struct input_device *device) {
+    struct input_device **bucket = get_bucket(device->devnum);
+    device->next_in_bucket = *bucket;
+    *bucket = device;
+
+    device->prev = NULL;
+    device->next = first_device;
+    if (first_device) {
+        first_device->prev = device;
+    }
+    first_device = device;
+
+    ++num_connected_devices;
+    num_keyboard_devices += is_keyboard_device(device);
+    num_pointer_devices += is_pointer_device(device);
+    num_touch_devices += is_touch_device(device);
+}
+
+static void unregister_device(struct input_device *device) {
+    for (struct input_device **link = get_bucket(device->devnum); *link; link = &((*link)->next_in_bucket)) {
+        if (*link == device) {
+            *link = device->next_in_bucket;
+            break;
         }
-        devices = tmp;
+    }
+
+    if (device->prev) {
+        device->prev->next = device->next;
+    } else {
+        first_device = device->next;
+    }
+    if (device->next) {
+        device->next->prev = device->prev;
+    }
+
+    --num_connected_devices;
+    num_keyboard_devices -= is_keyboard_device(device);
+    num_pointer_devices -= is_pointer_device(device);
+    num_touch_devices -= is_touch_device(device);
+}
 
-        /* Update size counter */
-        num_devices = 2 * num_devices + 1;
+static void connect_devnode(const char *node, dev_t devnum) {
+    /* Check if the device is already connected */
+    if (find_device(devnum)) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Ignoring already connected input device %s", node);
+        return;
+    }
 
-        /* Fill empty space with zeros */
-        lv_memzero(devices + num_connected_devices, (num_devices - num_connected_devices) * sizeof(struct input_device *));
+    /* Make sure the shared libinput context exists */
+    if (!init_libinput_context()) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Aborting connection of input device %s because libinput is unavailable", node);
+        return;
     }
 
-    /* Allocate memory for new input device and insert it */
+    /* Allocate memory for new input device */
     struct input_device *device = malloc(sizeof(struct input_device));
+    if (!device) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not allocate memory for input device %s", node);
+        return;
+    }
     lv_memzero(device, sizeof(struct input_device));
-    devices[num_connected_devices] = device;
+    device->devnum = devnum;
+    device->state = LV_INDEV_STATE_RELEASED;
+    device->touch_slot = -1;
 
     /* Copy the node path so that it can be used beyond the caller's scope */
     device->node = strdup(node);
 
-    /* Initialise the indev and obtain the libinput device */
-    device->indev = lv_libinput_create(LV_INDEV_TYPE_NONE, device->node);
-    if (!device->indev) {
-        bbx_log(BBX_LOG_LEVEL_WARNING, "Aborting connection of input device %s because libinput failed to connect it", node);
-        disconnect_idx(num_connected_devices);
-        return;
-    }
-    lv_libinput_t *dsc = lv_indev_get_driver_data(device->indev);
-    struct libinput_device *device_libinput = dsc->libinput_device;
-    if (!device_libinput) {
+    /* Add the device to the shared libinput context */
+    device->libinput_device = libinput_path_add_device(libinput_context, device->node);
+    if (!device->libinput_device) {
         bbx_log(BBX_LOG_LEVEL_WARNING, "Aborting connection of input device %s because libinput failed to connect it", node);
-        disconnect_idx(num_connected_devices);
+        free_device(device);
         return;
     }
+    libinput_device_set_user_data(device->libinput_device, device);
 
     /* Obtain device capabilities */
-    device->capability = lv_libinput_query_capability(device_libinput);
+    device->capability = lv_libinput_query_capability(device->libinput_device);
 
     /* If the device doesn't have any supported capabilities, exit */
     if ((device->capability & allowed_capability) == LV_LIBINPUT_CAPABILITY_NONE)  {
         bbx_log(BBX_LOG_LEVEL_WARNING, "Aborting connection of input device %s because it has no allowed capabilities", node);
-        disconnect_idx(num_connected_devices);
+        free_device(device);
+        return;
+    }
+
+    /* Create the LVGL indev */
+    device->indev = lv_indev_create();
+    if (!device->indev) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Aborting connection of input device %s because its indev could not be created", node);
+        free_device(device);
         return;
     }
+    lv_indev_set_read_cb(device->indev, read_cb);
+    lv_indev_set_driver_data(device->indev, device);
 
     /*
      * Set up indev type and related properties
@@ -256,9 +660,13 @@ static void connect_devnode(const char *node) {
         device->indev->long_press_repeat_time = USHRT_MAX;
     }
 
-    /* Set the input group for keyboard devices */
+    /* Set the input group and keymap for keyboard devices */
     if (is_keyboard_device(device)) {
         set_keyboard_input_group(device);
+#if LV_LIBINPUT_XKB
+        struct xkb_rule_names names = LV_LIBINPUT_XKB_KEY_MAP;
+        device->has_xkb = lv_xkb_init(&(device->xkb), names);
+#endif /* LV_LIBINPUT_XKB */
     }
 
     /* Set the mouse cursor for pointer devices */
@@ -266,8 +674,16 @@ static void connect_devnode(const char *node) {
         set_mouse_cursor(device);
     }
 
-    /* Increment connected device count */
-    num_connected_devices++;
+    /* Capture the device's events if an input trace is being recorded */
+    bbx_replay_record_indev(device->indev, is_touch_device(device));
+
+    /* Only read the device while it is active */
+    if (is_libinput_fd_watched) {
+        lv_timer_pause(lv_indev_get_read_timer(device->indev));
+    }
+
+    /* Add device to the registry */
+    register_device(device);
 
     bbx_log(BBX_LOG_LEVEL_VERBOSE, "Connected input device %s (%s)", node, capability_to_str(device->capability));
 }
@@ -280,59 +696,47 @@ static void disconnect_udev_device(struct udev_device *device) {
         return;
     }
 
-    /* Disconnect device using its node */
-    disconnect_devnode(node);
-}
-
-static void disconnect_devnode(const char *node) {
-    /* Find connected device matching the specified node */
-    int idx = -1;
-    for (int i = 0; i < num_connected_devices; ++i) {
-        if (strcmp(devices[i]->node, node) == 0) {
-            idx = i;
-            break;
-        }
-    }
-
-    /* If no matching device was found, exit */
-    if (idx < 0) {
+    /* Find connected device matching the device number */
+    struct input_device *input_device = find_device(udev_device_get_devnum(device));
+    if (!input_device) {
         bbx_log(BBX_LOG_LEVEL_WARNING, "Ignoring already disconnected input device %s", node);
         return;
     }
 
-    /* Disconnect device using its index */
-    disconnect_idx(idx);
+    disconnect_device(input_device);
+}
 
-    /* Shift subsequent devices forward */
-    for (int i = idx + 1; i < num_connected_devices; ++i) {
-        devices[i - 1] = devices[i];
+static void disconnect_device(struct input_device *device) {
+    bbx_log(BBX_LOG_LEVEL_VERBOSE, "Disconnected input device %s", device->node);
+    unregister_device(device);
+    free_device(device);
+}
 
-        /* Zero out the last element after shifting it forward */
-        if (i == num_connected_devices - 1) {
-            lv_memzero(devices + i, sizeof(struct input_device *));
-        }
+static void free_device(struct input_device *device) {
+    /* Delete LVGL indev */
+    if (device->indev) {
+        lv_indev_delete(device->indev);
     }
-    
-    /* Decrement connected device count */
-    --num_connected_devices;
 
-    bbx_log(BBX_LOG_LEVEL_VERBOSE, "Disconnected input device %s", node);
-}
+    /* Remove the device from the libinput context, detaching it from any still queued events first */
+    if (device->libinput_device) {
+        libinput_device_set_user_data(device->libinput_device, NULL);
+        libinput_path_remove_device(device->libinput_device);
+    }
 
-static void disconnect_idx(int idx) {
-    /* Delete LVGL indev */
-    if (devices[idx]->indev) {
-        lv_libinput_delete(devices[idx]->indev);
+#if LV_LIBINPUT_XKB
+    /* Free keymap */
+    if (device->has_xkb) {
+        lv_xkb_deinit(&(device->xkb));
     }
+#endif /* LV_LIBINPUT_XKB */
 
     /* Free previously copied node path */
-    if (devices[idx]->node) {
-        free(devices[idx]->node);
+    if (device->node) {
+        free(device->node);
     }
 
-    /* Deallocate memory and zero out freed array element */
-    free(devices[idx]);
-    lv_memzero(devices + idx, sizeof(struct input_device *));
+    free(device);
 }
 
 static void set_keyboard_input_group(struct input_device *device) {
@@ -361,6 +765,585 @@ static void set_mouse_cursor(struct input_device *device) {
     lv_indev_set_cursor(device->indev, cursor_obj);
 }
 
+static int open_restricted(const char *path, int flags, void *user_data) {
+    LV_UNUSED(user_data);
+
+    /* Hand over the file descriptor opened by the probe thread */
+    if (probe_in_connection && probe_in_connection->fd >= 0 && strcmp(path, probe_in_connection->node) == 0) {
+        int fd = probe_in_connection->fd;
+        probe_in_connection->fd = -1;
+        return fd;
+    }
+
+    int fd = open(path, flags | O_CLOEXEC);
+    return fd < 0 ? -errno : fd;
+}
+
+static void close_restricted(int fd, void *user_data) {
+    LV_UNUSED(user_data);
+    close(fd);
+}
+
+static const struct libinput_interface libinput_interface = {
+    .open_restricted = open_restricted,
+    .close_restricted = close_restricted
+};
+
+static bool test_bit(const unsigned long *bits, int bit) {
+    return (bits[bit / (8 * sizeof(unsigned long))] >> (bit % (8 * sizeof(unsigned long)))) & 1;
+}
+
+static lv_libinput_capability estimate_capability(int fd) {
+    unsigned long ev_bits[(EV_MAX + 1 + 8 * sizeof(unsigned long) - 1) / (8 * sizeof(unsigned long))] = { 0 };
+    unsigned long key_bits[(KEY_MAX + 1 + 8 * sizeof(unsigned long) - 1) / (8 * sizeof(unsigned long))] = { 0 };
+    unsigned long rel_bits[(REL_MAX + 1 + 8 * sizeof(unsigned long) - 1) / (8 * sizeof(unsigned long))] = { 0 };
+
+    if (ioctl(fd, EVIOCGBIT(0, sizeof(ev_bits)), ev_bits) < 0) {
+        /* Let libinput decide */
+        return LV_LIBINPUT_CAPABILITY_KEYBOARD | LV_LIBINPUT_CAPABILITY_POINTER | LV_LIBINPUT_CAPABILITY_TOUCH;
+    }
+
+    lv_libinput_capability capability = LV_LIBINPUT_CAPABILITY_NONE;
+
+    if (test_bit(ev_bits, EV_KEY) && ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(key_bits)), key_bits) >= 0) {
+        /* Like libinput, treat any device with non-button keys as a keyboard */
+        for (int key = KEY_ESC; key < BTN_MISC; ++key) {
+            if (test_bit(key_bits, key)) {
+                capability |= LV_LIBINPUT_CAPABILITY_KEYBOARD;
+                break;
+            }
+        }
+    }
+
+    if (test_bit(ev_bits, EV_REL) && ioctl(fd, EVIOCGBIT(EV_REL, sizeof(rel_bits)), rel_bits) >= 0
+            && test_bit(rel_bits, REL_X) && test_bit(rel_bits, REL_Y)) {
+        capability |= LV_LIBINPUT_CAPABILITY_POINTER;
+    }
+
+    /* Absolute axes can belong to touchscreens, touchpads or tablets */
+    if (test_bit(ev_bits, EV_ABS)) {
+        capability |= LV_LIBINPUT_CAPABILITY_POINTER | LV_LIBINPUT_CAPABILITY_TOUCH;
+    }
+
+    return capability;
+}
+
+static void probe_devnode(struct probe_job *job) {
+    uint64_t start_us = bbx_tick_get_us();
+
+    job->fd = open(job->node, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (job->fd >= 0) {
+        job->capability = estimate_capability(job->fd);
+
+        /* Don't bother libinput with devices that can't match */
+        if ((job->capability & allowed_capability) == LV_LIBINPUT_CAPABILITY_NONE) {
+            close(job->fd);
+            job->fd = -1;
+        }
+    }
+
+    job->probe_time_us = bbx_tick_get_us() - start_us;
+}
+
+static void *probe_thread(void *arg) {
+    LV_UNUSED(arg);
+
+    while (true) {
+        pthread_mutex_lock(&probe_mutex);
+        struct probe_job *job = queued_probes;
+        if (job) {
+            queued_probes = job->next;
+        }
+        pthread_mutex_unlock(&probe_mutex);
+
+        if (!job) {
+            break;
+        }
+
+        probe_devnode(job);
+
+        pthread_mutex_lock(&probe_mutex);
+        job->next = finished_probes;
+        finished_probes = job;
+        pthread_mutex_unlock(&probe_mutex);
+
+        /* Wake up the main thread */
+        uint64_t one = 1;
+        if (write(probe_event_fd, &one, sizeof(one)) < 0) {
+            bbx_log(BBX_LOG_LEVEL_WARNING, "Could not signal finished probe of input device %s", job->node);
+        }
+    }
+
+    return NULL;
+}
+
+static void probe_event_fd_ready_cb(int fd, uint32_t events, void *user_data) {
+    LV_UNUSED(events);
+    LV_UNUSED(user_data);
+
+    uint64_t count;
+    if (read(fd, &count, sizeof(count)) < 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&probe_mutex);
+    struct probe_job *jobs = finished_probes;
+    finished_probes = NULL;
+    pthread_mutex_unlock(&probe_mutex);
+
+    while (jobs) {
+        struct probe_job *job = jobs;
+        jobs = job->next;
+
+        if (job->fd >= 0) {
+            bbx_log(BBX_LOG_LEVEL_VERBOSE, "Probed input device %s in %.2f ms", job->node, job->probe_time_us / 1000.0);
+            probe_in_connection = job;
+            connect_devnode(job->node, job->devnum);
+            probe_in_connection = NULL;
+        } else {
+            bbx_log(BBX_LOG_LEVEL_VERBOSE, "Probed input device %s in %.2f ms, skipping it (%s)", job->node,
+                job->probe_time_us / 1000.0, job->capability == LV_LIBINPUT_CAPABILITY_NONE ? "could not open or no capabilities" : "no allowed capabilities");
+        }
+
+        /* Close the file descriptor if libinput didn't take it over (e.g. already connected device) */
+        if (job->fd >= 0) {
+            close(job->fd);
+        }
+        free(job->node);
+        free(job);
+
+        --num_running_probes;
+    }
+
+    if (num_running_probes == 0) {
+        bbx_log(BBX_LOG_LEVEL_VERBOSE, "Finished auto-connecting input devices in %.2f ms", (bbx_tick_get_us() - probe_start_us) / 1000.0);
+        if (auto_connect_finished_cb) {
+            auto_connect_finished_cb();
+        }
+    }
+}
+
+static bool start_probe_threads(struct probe_job *jobs, int num_jobs) {
+    /* Set up the file descriptor for waking up the main thread once */
+    if (probe_event_fd < 0) {
+        probe_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (probe_event_fd < 0) {
+            bbx_log(BBX_LOG_LEVEL_WARNING, "Could not create probe event file descriptor: %s", strerror(errno));
+            return false;
+        }
+        if (!bbx_event_loop_add_fd(probe_event_fd, EPOLLIN, probe_event_fd_ready_cb, NULL)) {
+            close(probe_event_fd);
+            probe_event_fd = -1;
+            return false;
+        }
+    }
+
+    /* Queue jobs */
+    pthread_mutex_lock(&probe_mutex);
+    struct probe_job *last = jobs;
+    while (last->next) {
+        last = last->next;
+    }
+    last->next = queued_probes;
+    queued_probes = jobs;
+    pthread_mutex_unlock(&probe_mutex);
+
+    num_running_probes += num_jobs;
+
+    /* Spawn workers. Any that fail to start are compensated by the others draining the queue. */
+    int num_threads = 0;
+    for (int i = 0; i < LV_MIN(num_jobs, MAX_PROBE_THREADS); ++i) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, probe_thread, NULL) == 0) {
+            pthread_detach(thread);
+            ++num_threads;
+        }
+    }
+
+    if (num_threads == 0) {
+        /* Take the jobs back and let the caller handle them */
+        pthread_mutex_lock(&probe_mutex);
+        queued_probes = last->next;
+        last->next = NULL;
+        pthread_mutex_unlock(&probe_mutex);
+        num_running_probes -= num_jobs;
+        return false;
+    }
+
+    bbx_log(BBX_LOG_LEVEL_VERBOSE, "Probing %d input devices on %d threads", num_jobs, num_threads);
+    return true;
+}
+
+static bool init_libinput_context(void) {
+    if (libinput_context) {
+        return true;
+    }
+
+    libinput_context = libinput_path_create_context(&libinput_interface, NULL);
+    if (!libinput_context) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not create libinput context");
+        return false;
+    }
+
+    /* Dispatch events as they arrive and fall back to polling from the read timers otherwise */
+    libinput_fd = libinput_get_fd(libinput_context);
+    if (bbx_event_loop_add_fd(libinput_fd, EPOLLIN, libinput_fd_ready_cb, NULL)) {
+        is_libinput_fd_watched = true;
+        idle_timer = lv_timer_create(idle_timer_cb, DEVICE_IDLE_TIMEOUT, NULL);
+        lv_timer_pause(idle_timer);
+    } else {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Could not watch libinput file descriptor, reading input devices continuously");
+    }
+
+    /* Count frames for the read time statistics */
+    lv_display_t *disp = lv_display_get_default();
+    if (disp) {
+        lv_display_add_event_cb(disp, refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+    }
+    stats_window_start_us = bbx_tick_get_us();
+
+    return true;
+}
+
+static void queue_libinput_event(struct input_device *device, struct libinput_event *event) {
+    lv_display_t *disp = lv_display_get_default();
+    int32_t hor_res = disp->physical_hor_res > 0 ? disp->physical_hor_res : disp->hor_res;
+    int32_t ver_res = disp->physical_ver_res > 0 ? disp->physical_ver_res : disp->ver_res;
+
+    /* Start from the state after the most recently queued event */
+    struct queued_event queued = { .point = device->point, .key = device->key, .state = device->state };
+    if (device->queue_length > 0) {
+        queued = device->queue[(device->queue_start + device->queue_length - 1) % MAX_QUEUED_EVENTS];
+    }
+    queued.is_motion = false;
+
+    if (lv_indev_get_type(device->indev) == LV_INDEV_TYPE_KEYPAD) {
+        if (libinput_event_get_type(event) != LIBINPUT_EVENT_KEYBOARD_KEY) {
+            return;
+        }
+
+        struct libinput_event_keyboard *keyboard_event = libinput_event_get_keyboard_event(event);
+        uint32_t code = libinput_event_keyboard_get_key(keyboard_event);
+        bool is_pressed = libinput_event_keyboard_get_key_state(keyboard_event) == LIBINPUT_KEY_STATE_PRESSED;
+
+#if LV_LIBINPUT_XKB
+        queued.key = device->has_xkb ? lv_xkb_process_key(&(device->xkb), code, is_pressed) : 0;
+#else
+        switch (code) {
+            case KEY_BACKSPACE:
+                queued.key = LV_KEY_BACKSPACE;
+                break;
+            case KEY_ENTER:
+                queued.key = LV_KEY_ENTER;
+                break;
+            case KEY_PREVIOUS:
+                queued.key = LV_KEY_PREV;
+                break;
+            case KEY_NEXT:
+            case KEY_TAB:
+                queued.key = LV_KEY_NEXT;
+                break;
+            case KEY_UP:
+                queued.key = LV_KEY_UP;
+                break;
+            case KEY_LEFT:
+                queued.key = LV_KEY_LEFT;
+                break;
+            case KEY_RIGHT:
+                queued.key = LV_KEY_RIGHT;
+                break;
+            case KEY_DOWN:
+                queued.key = LV_KEY_DOWN;
+                break;
+            default:
+                queued.key = 0;
+                break;
+        }
+#endif /* LV_LIBINPUT_XKB */
+
+        if (queued.key == 0) {
+            return;
+        }
+        queued.state = is_pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    } else {
+        switch (libinput_event_get_type(event)) {
+            case LIBINPUT_EVENT_POINTER_MOTION: {
+                struct libinput_event_pointer *pointer_event = libinput_event_get_pointer_event(event);
+                queued.point.x = LV_CLAMP(0, queued.point.x + (int32_t)libinput_event_pointer_get_dx(pointer_event), disp->hor_res - 1);
+                queued.point.y = LV_CLAMP(0, queued.point.y + (int32_t)libinput_event_pointer_get_dy(pointer_event), disp->ver_res - 1);
+                queued.is_motion = true;
+                break;
+            }
+            case LIBINPUT_EVENT_POINTER_MOTION_ABSOLUTE: {
+                struct libinput_event_pointer *pointer_event = libinput_event_get_pointer_event(event);
+                queued.point.x = (int32_t)libinput_event_pointer_get_absolute_x_transformed(pointer_event, hor_res) - disp->offset_x;
+                queued.point.y = (int32_t)libinput_event_pointer_get_absolute_y_transformed(pointer_event, ver_res) - disp->offset_y;
+                queued.is_motion = true;
+                break;
+            }
+            case LIBINPUT_EVENT_POINTER_BUTTON: {
+                struct libinput_event_pointer *pointer_event = libinput_event_get_pointer_event(event);
+                bool is_pressed = libinput_event_pointer_get_button_state(pointer_event) == LIBINPUT_BUTTON_STATE_PRESSED;
+                queued.state = is_pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+                break;
+            }
+            case LIBINPUT_EVENT_TOUCH_DOWN:
+            case LIBINPUT_EVENT_TOUCH_MOTION: {
+                /* Only follow the first finger */
+                struct libinput_event_touch *touch_event = libinput_event_get_touch_event(event);
+                int32_t slot = libinput_event_touch_get_slot(touch_event);
+                if (device->touch_slot >= 0 && slot != device->touch_slot) {
+                    return;
+                }
+                device->touch_slot = slot;
+                queued.point.x = (int32_t)libinput_event_touch_get_x_transformed(touch_event, hor_res) - disp->offset_x;
+                queued.point.y = (int32_t)libinput_event_touch_get_y_transformed(touch_event, ver_res) - disp->offset_y;
+                queued.state = LV_INDEV_STATE_PRESSED;
+                queued.is_motion = libinput_event_get_type(event) == LIBINPUT_EVENT_TOUCH_MOTION;
+                break;
+            }
+            case LIBINPUT_EVENT_TOUCH_UP: {
+                struct libinput_event_touch *touch_event = libinput_event_get_touch_event(event);
+                if (libinput_event_touch_get_slot(touch_event) != device->touch_slot) {
+                    return;
+                }
+                device->touch_slot = -1;
+                queued.state = LV_INDEV_STATE_RELEASED;
+                break;
+            }
+            default:
+                return;
+        }
+    }
+
+    /* Merge consecutive moves so that bursts of motion don't overflow the queue */
+    if (device->queue_length > 0 && queued.is_motion) {
+        struct queued_event *last = &(device->queue[(device->queue_start + device->queue_length - 1) % MAX_QUEUED_EVENTS]);
+        if (last->is_motion && last->state == queued.state) {
+            last->point = queued.point;
+            device->has_new_events = true;
+            return;
+        }
+    }
+
+    if (device->queue_length == MAX_QUEUED_EVENTS) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Dropping event because the queue of input device %s is full", device->node);
+        return;
+    }
+
+    device->queue[(device->queue_start + device->queue_length) % MAX_QUEUED_EVENTS] = queued;
+    ++device->queue_length;
+    device->has_new_events = true;
+    ++stats_num_events;
+}
+
+static void dispatch_libinput(bool read_devices) {
+    if (libinput_dispatch(libinput_context) < 0) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Could not dispatch libinput events");
+    }
+
+    struct libinput_event *event;
+    while ((event = libinput_get_event(libinput_context)) != NULL) {
+        /* Devices that are being disconnected have their user data cleared */
+        struct input_device *device = libinput_device_get_user_data(libinput_event_get_device(event));
+        if (device && device->indev) {
+            queue_libinput_event(device, event);
+        }
+        libinput_event_destroy(event);
+    }
+
+    if (!read_devices) {
+        return;
+    }
+
+    for (struct input_device *device = first_device; device; device = device->next) {
+        if (!device->has_new_events) {
+            continue;
+        }
+        device->has_new_events = false;
+
+        /* Process the events right away rather than waiting for the next read timer period */
+        lv_indev_read(device->indev);
+
+        /* Keep reading until the device is idle (e.g. for long presses) */
+        lv_timer_resume(lv_indev_get_read_timer(device->indev));
+        lv_timer_reset(idle_timer);
+        lv_timer_resume(idle_timer);
+    }
+}
+
+static void read_cb(lv_indev_t *indev, lv_indev_data_t *data) {
+    struct input_device *device = lv_indev_get_driver_data(indev);
+    uint64_t start_us = is_dispatching ? 0 : bbx_tick_get_us();
+
+    /* Without the event loop, poll libinput from the read timers */
+    if (!is_libinput_fd_watched) {
+        dispatch_libinput(false);
+    }
+
+    if (device->queue_length > 0) {
+        const struct queued_event *queued = &(device->queue[device->queue_start]);
+        device->point = queued->point;
+        device->key = queued->key;
+        device->state = queued->state;
+        device->queue_start = (device->queue_start + 1) % MAX_QUEUED_EVENTS;
+        --device->queue_length;
+    }
+
+    data->point = device->point;
+    data->key = device->key;
+    data->state = device->state;
+    data->continue_reading = device->queue_length > 0;
+
+    if (!is_dispatching) {
+        stats_read_time_us += bbx_tick_get_us() - start_us;
+    }
+}
+
+static void libinput_fd_ready_cb(int fd, uint32_t events, void *user_data) {
+    LV_UNUSED(fd);
+    LV_UNUSED(events);
+    LV_UNUSED(user_data);
+
+    uint64_t start_us = bbx_tick_get_us();
+    is_dispatching = true;
+    dispatch_libinput(true);
+    is_dispatching = false;
+    stats_read_time_us += bbx_tick_get_us() - start_us;
+}
+
+static void refr_ready_cb(lv_event_t *event) {
+    LV_UNUSED(event);
+
+    ++stats_num_frames;
+
+    uint64_t elapsed_us = bbx_tick_get_us() - stats_window_start_us;
+    if (elapsed_us < READ_STATS_WINDOW_US) {
+        return;
+    }
+
+    if (stats_num_events > 0) {
+        bbx_log(BBX_LOG_LEVEL_VERBOSE, "Input: %.1f us read time per frame over %u frames, %u events from %d devices",
+            (double)stats_read_time_us / stats_num_frames, stats_num_frames, stats_num_events, num_connected_devices);
+    }
+
+    stats_window_start_us += elapsed_us;
+    stats_read_time_us = 0;
+    stats_num_frames = 0;
+    stats_num_events = 0;
+}
+
+static void idle_timer_cb(lv_timer_t *timer) {
+    bool is_any_pressed = false;
+
+    for (struct input_device *device = first_device; device; device = device->next) {
+        /* Keep reading devices that are still pressed (e.g. for long presses) or have queued events */
+        if (device->indev->state == LV_INDEV_STATE_PRESSED || device->queue_length > 0) {
+            is_any_pressed = true;
+            continue;
+        }
+        lv_timer_pause(lv_indev_get_read_timer(device->indev));
+    }
+
+    if (!is_any_pressed) {
+        lv_timer_pause(timer);
+    }
+}
+
+static int receive_monitor_events(void) {
+    int num_received = 0;
+
+    /* The monitor socket is non-blocking so this stops once the queue is drained */
+    struct udev_device *device;
+    while ((device = udev_monitor_receive_device(monitor)) != NULL) {
+        /* Double array size every time it's filled */
+        if (num_pending_devices == max_pending_devices) {
+            struct udev_device **tmp = realloc(pending_devices, (2 * max_pending_devices + 1) * sizeof(struct udev_device *));
+            if (!tmp) {
+                bbx_log(BBX_LOG_LEVEL_ERROR, "Could not reallocate memory for pending input devices");
+                udev_device_unref(device);
+                continue;
+            }
+            pending_devices = tmp;
+            max_pending_devices = 2 * max_pending_devices + 1;
+        }
+
+        pending_devices[num_pending_devices++] = device;
+        ++num_received;
+    }
+
+    return num_received;
+}
+
+static void process_pending_devices(void) {
+    int num_superseded = 0;
+
+    for (int i = 0; i < num_pending_devices; ++i) {
+        struct udev_device *device = pending_devices[i];
+        const char *node = udev_device_get_devnode(device);
+        const char *action = udev_device_get_action(device);
+
+        /* Skip events that are superseded by a later event for the same node and remember removals */
+        bool is_superseded = false;
+        bool was_removed = false;
+        for (int j = 0; node && j < num_pending_devices; ++j) {
+            const char *other_node = udev_device_get_devnode(pending_devices[j]);
+            if (j == i || !other_node || strcmp(node, other_node) != 0) {
+                continue;
+            }
+            if (j > i) {
+                is_superseded = true;
+                break;
+            }
+            was_removed |= strcmp(udev_device_get_action(pending_devices[j]), "remove") == 0;
+        }
+
+        if (is_superseded) {
+            ++num_superseded;
+        } else if (strcmp(action, "add") == 0) {
+            /* If the node was re-plugged, drop the stale connection first */
+            struct input_device *stale_device = was_removed ? find_device(udev_device_get_devnum(device)) : NULL;
+            if (stale_device) {
+                disconnect_device(stale_device);
+            }
+            connect_udev_device(device);
+        } else if (strcmp(action, "remove") == 0) {
+            disconnect_udev_device(device);
+        }
+    }
+
+    if (num_pending_devices > 0) {
+        bbx_log(BBX_LOG_LEVEL_VERBOSE, "Processed %d udev event(s) in one pass, %d superseded", num_pending_devices, num_superseded);
+    }
+
+    for (int i = 0; i < num_pending_devices; ++i) {
+        udev_device_unref(pending_devices[i]);
+    }
+    num_pending_devices = 0;
+}
+
+static void monitor_fd_ready_cb(int fd, uint32_t events, void *user_data) {
+    LV_UNUSED(fd);
+    LV_UNUSED(events);
+    LV_UNUSED(user_data);
+
+    if (receive_monitor_events() == 0) {
+        return;
+    }
+
+    /* Give bursts (e.g. a hub bringing up several devices) a moment to settle. The timer isn't
+     * reset on later events so that a continuous stream can't delay processing indefinitely. */
+    if (lv_timer_get_paused(hotplug_timer)) {
+        lv_timer_reset(hotplug_timer);
+        lv_timer_resume(hotplug_timer);
+    }
+}
+
+static void hotplug_timer_cb(lv_timer_t *timer) {
+    lv_timer_pause(timer);
+    process_pending_devices();
+}
+
 static void query_device_monitor(lv_timer_t *timer) {
     LV_UNUSED(timer);
     bbx_indev_query_monitor();
@@ -389,22 +1372,24 @@ void bbx_indev_set_keyboard_input_group(lv_group_t *group) {
     keyboard_input_group = group;
 
     /* Apply the group on all connected keyboard devices */
-    for (int i = 0; i < num_connected_devices; ++i) {
-        if (is_keyboard_device(devices[i])) {
-            set_keyboard_input_group(devices[i]);
-        }
+    for (struct input_device *device = first_device; device; device = device->next) {
+        set_keyboard_input_group(device);
     }
 }
 
 void bbx_indev_start_monitor_and_autoconnect(bool keyboard, bool pointer, bool touchscreen) {
     bbx_indev_set_allowed_device_capability(keyboard, pointer, touchscreen);
     bbx_indev_start_monitor();
-    lv_timer_create(query_device_monitor, 1000, NULL);
     bbx_indev_auto_connect();
 }
 
+void bbx_indev_set_auto_connect_finished_cb(bbx_indev_auto_connect_finished_cb cb) {
+    auto_connect_finished_cb = cb;
+}
+
 void bbx_indev_auto_connect() {
     bbx_log(BBX_LOG_LEVEL_VERBOSE, "Auto-connecting supported input devices");
+    probe_start_us = bbx_tick_get_us();
 
     /* Make sure udev context is initialised */
     if (!context) {
@@ -424,6 +1409,9 @@ void bbx_indev_auto_connect() {
     struct udev_list_entry *first_entry = udev_enumerate_get_list_entry(enumerate);
     struct udev_list_entry *entry;
 
+    struct probe_job *jobs = NULL;
+    int num_jobs = 0;
+
     udev_list_entry_foreach(entry, first_entry) {
         /* Obtain system path */
         const char *path = udev_list_entry_get_name(entry);
@@ -435,8 +1423,20 @@ void bbx_indev_auto_connect() {
             continue;
         }
 
-        /* Connect device */
-        connect_udev_device(device);
+        /* Queue a probe job for supported device nodes */
+        const char *node = udev_device_get_devnode(device);
+        if (should_connect_udev_device(device)) {
+            struct probe_job *job = malloc(sizeof(struct probe_job));
+            if (job) {
+                lv_memzero(job, sizeof(struct probe_job));
+                job->node = strdup(node);
+                job->devnum = udev_device_get_devnum(device);
+                job->fd = -1;
+                job->next = jobs;
+                jobs = job;
+                ++num_jobs;
+            }
+        }
 
         /* Unreference udev device */
         udev_device_unref(device);
@@ -444,6 +1444,24 @@ void bbx_indev_auto_connect() {
 
     /* Unreference enumeration */
     udev_enumerate_unref(enumerate);
+
+    /* Open devices in parallel and hand them over as they're ready */
+    if (num_jobs > 0 && start_probe_threads(jobs, num_jobs)) {
+        return;
+    }
+
+    /* Fall back to connecting devices synchronously */
+    while (jobs) {
+        struct probe_job *job = jobs;
+        jobs = job->next;
+        connect_devnode(job->node, job->devnum);
+        free(job->node);
+        free(job);
+    }
+
+    if (auto_connect_finished_cb) {
+        auto_connect_finished_cb();
+    }
 }
 
 void bbx_indev_start_monitor() {
@@ -488,9 +1506,39 @@ void bbx_indev_start_monitor() {
         bbx_indev_stop_monitor();
         return;
     }
+
+    /* Handle events as soon as they arrive and fall back to polling if that's not possible */
+    if (bbx_event_loop_add_fd(monitor_fd, EPOLLIN, monitor_fd_ready_cb, NULL)) {
+        is_monitor_fd_watched = true;
+        hotplug_timer = lv_timer_create(hotplug_timer_cb, HOTPLUG_SETTLE_TIME, NULL);
+        lv_timer_pause(hotplug_timer);
+    } else {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Could not watch udev monitor, polling it instead");
+        monitor_timer = lv_timer_create(query_device_monitor, MONITOR_POLL_PERIOD, NULL);
+    }
 }
 
 void bbx_indev_stop_monitor() {
+    /* Stop watching or polling the monitor */
+    if (is_monitor_fd_watched) {
+        bbx_event_loop_remove_fd(monitor_fd);
+        is_monitor_fd_watched = false;
+    }
+    if (hotplug_timer) {
+        lv_timer_delete(hotplug_timer);
+        hotplug_timer = NULL;
+    }
+    if (monitor_timer) {
+        lv_timer_delete(monitor_timer);
+        monitor_timer = NULL;
+    }
+
+    /* Drop events that haven't been processed yet */
+    for (int i = 0; i < num_pending_devices; ++i) {
+        udev_device_unref(pending_devices[i]);
+    }
+    num_pending_devices = 0;
+
     /* Unreference monitor */
     if (monitor) {
         udev_monitor_unref(monitor);
@@ -516,42 +1564,37 @@ void bbx_indev_query_monitor() {
         return;
     }
 
-    /* Prepare file descriptor set for reading */
-    fd_set fds;
-    FD_ZERO(&fds);
-    FD_SET(monitor_fd, &fds);
-
-    /* Set up timeval to not block when no updates are available */
-    struct timeval tv = { .tv_sec = 0, .tv_usec = 0 };
-
     /* Read and process all updates */
-    while (select(monitor_fd + 1, &fds, NULL, NULL, &tv) > 0 && FD_ISSET(monitor_fd, &fds)) {
-        /* Obtain udev device */
-        struct udev_device *device = udev_monitor_receive_device(monitor);
-        if (!device) {
-            continue;
-        }
-
-        /* Obtain action */
-        const char *action = udev_device_get_action(device);
+    receive_monitor_events();
+    process_pending_devices();
+}
 
-        /* Connect or disconnect the device */
-        if (strcmp(action, "add") == 0) {
-            connect_udev_device(device);
-        } else if (strcmp(action, "remove") == 0) {
-            disconnect_udev_device(device);
-        }
+bool bbx_indev_is_keyboard_connected() {
+    return num_keyboard_devices > 0;
+}
 
-        /* Unreference udev device */
-        udev_device_unref(device);
+int bbx_indev_get_num_connected_devices(lv_libinput_capability capability) {
+    switch (capability) {
+        case LV_LIBINPUT_CAPABILITY_KEYBOARD:
+            return num_keyboard_devices;
+        case LV_LIBINPUT_CAPABILITY_POINTER:
+            return num_pointer_devices;
+        case LV_LIBINPUT_CAPABILITY_TOUCH:
+            return num_touch_devices;
+        default:
+            return num_connected_devices;
     }
 }
 
-bool bbx_indev_is_keyboard_connected() {
-    for (int i = 0; i < num_connected_devices; ++i) {
-        if (is_keyboard_device(devices[i])) {
-            return true;
+void bbx_indev_foreach_device(bbx_indev_foreach_cb cb, void *user_data) {
+    for (struct input_device *device = first_device; device; device = device->next) {
+        bbx_indev_device_info info = {
+            .node = device->node,
+            .capability = device->capability,
+            .indev = device->indev
+        };
+        if (!cb(&info, user_data)) {
+            break;
         }
     }
-    return false;
 }
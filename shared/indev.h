@@ -11,6 +11,32 @@
 
 #include <stdbool.h>
 
+/**
+ * Callback for when auto-connecting input devices has finished.
+ */
+typedef void (*bbx_indev_auto_connect_finished_cb)(void);
+
+/**
+ * Information about a connected input device
+ */
+typedef struct {
+    /* Device node path */
+    const char *node;
+    /* Capabilities reported by libinput */
+    lv_libinput_capability capability;
+    /* LVGL input device */
+    lv_indev_t *indev;
+} bbx_indev_device_info;
+
+/**
+ * Callback for iterating connected input devices.
+ *
+ * @param info information about the device, only valid during the call
+ * @param user_data user data supplied to bbx_indev_foreach_device
+ * @return true to continue iterating, false to stop
+ */
+typedef bool (*bbx_indev_foreach_cb)(const bbx_indev_device_info *info, void *user_data);
+
 /**
  * Set the required capabilities for input devices.
  *
@@ -37,12 +63,22 @@ void bbx_indev_set_keyboard_input_group(lv_group_t *group);
 void bbx_indev_start_monitor_and_autoconnect(bool keyboard, bool pointer, bool touchscreen);
 
 /**
- * Auto-connect currently available keyboard, pointer and touchscreen input devices.
+ * Set the callback to invoke on the main thread once auto-connecting input devices has finished.
+ *
+ * @param cb the callback or NULL
+ */
+void bbx_indev_set_auto_connect_finished_cb(bbx_indev_auto_connect_finished_cb cb);
+
+/**
+ * Auto-connect currently available keyboard, pointer and touchscreen input devices. Device nodes
+ * are opened and classified on worker threads so this returns immediately and devices get
+ * connected on the main thread while the event loop is running.
  */
 void bbx_indev_auto_connect();
 
 /**
- * Start the udev device monitor.
+ * Start the udev device monitor. Events are handled through the event loop as they arrive, with
+ * bursts being coalesced into a single pass.
  */
 void bbx_indev_start_monitor();
 
@@ -63,4 +99,21 @@ void bbx_indev_query_monitor();
  */
 bool bbx_indev_is_keyboard_connected();
 
+/**
+ * Get the number of connected devices with a capability.
+ *
+ * @param capability LV_LIBINPUT_CAPABILITY_KEYBOARD, _POINTER or _TOUCH, or LV_LIBINPUT_CAPABILITY_NONE to count all devices
+ * @return number of connected devices
+ */
+int bbx_indev_get_num_connected_devices(lv_libinput_capability capability);
+
+/**
+ * Invoke a callback for every connected input device. Devices must not be (dis)connected from
+ * within the callback.
+ *
+ * @param cb callback to invoke
+ * @param user_data user data to pass to the callback
+ */
+void bbx_indev_foreach_device(bbx_indev_foreach_cb cb, void *user_data);
+
 #endif /* BBX_INDEV_H */
@@ -0,0 +1,145 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#include "memory_display.h"
+
+#include "log.h"
+#include "tick.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+
+
+/**
+ * Static variables
+ */
+
+static const struct {
+    const char *name;
+    lv_color_format_t format;
+} formats[] = {
+    { "rgb565", LV_COLOR_FORMAT_RGB565 },
+    { "rgb888", LV_COLOR_FORMAT_RGB888 },
+    { "xrgb8888", LV_COLOR_FORMAT_XRGB8888 },
+    { "argb8888", LV_COLOR_FORMAT_ARGB8888 }
+};
+
+static uint32_t frame_count = 0;
+static uint64_t frame_start_us = 0;
+static uint64_t frame_flush_us = 0;
+static uint32_t frame_bytes = 0;
+
+
+/**
+ * Static prototypes
+ */
+
+/**
+ * Flush callback. Pixels are rendered straight into the mapped file, so this only does the accounting.
+ *
+ * @param disp display being flushed
+ * @param area area being flushed
+ * @param px_map rendered pixels
+ */
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
+
+/**
+ * Handle LV_EVENT_REFR_START and LV_EVENT_REFR_READY events from the display.
+ *
+ * @param event the event object
+ */
+static void refresh_event_cb(lv_event_t *event);
+
+
+/**
+ * Static functions
+ */
+
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    LV_UNUSED(px_map);
+
+    uint64_t start_us = bbx_tick_get_us();
+    frame_bytes += lv_area_get_size(area) * lv_color_format_get_size(lv_display_get_color_format(disp));
+    lv_display_flush_ready(disp);
+    frame_flush_us += bbx_tick_get_us() - start_us;
+}
+
+static void refresh_event_cb(lv_event_t *event) {
+    if (lv_event_get_code(event) == LV_EVENT_REFR_START) {
+        frame_start_us = bbx_tick_get_us();
+        frame_flush_us = 0;
+        frame_bytes = 0;
+        return;
+    }
+
+    /* Skip refreshes that didn't draw anything */
+    if (frame_bytes == 0) {
+        return;
+    }
+
+    uint64_t total_us = bbx_tick_get_us() - frame_start_us;
+    bbx_log(BBX_LOG_LEVEL_VERBOSE, "Frame %u: rendered in %.3f ms, flushed %u bytes in %.3f ms",
+        ++frame_count, (total_us - frame_flush_us) / 1000.0, frame_bytes, frame_flush_us / 1000.0);
+}
+
+
+/**
+ * Public functions
+ */
+
+lv_display_t *bbx_memory_display_create(const char *path, uint32_t width, uint32_t height, lv_color_format_t format) {
+    uint32_t stride = lv_draw_buf_width_to_stride(width, format);
+    size_t size = (size_t)stride * height;
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not open %s: %s", path, strerror(errno));
+        return NULL;
+    }
+
+    if (ftruncate(fd, size) < 0) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not resize %s: %s", path, strerror(errno));
+        close(fd);
+        return NULL;
+    }
+
+    uint8_t *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not map %s: %s", path, strerror(errno));
+        return NULL;
+    }
+
+    lv_display_t *disp = lv_display_create(width, height);
+    if (!disp) {
+        munmap(map, size);
+        return NULL;
+    }
+
+    /* Render directly into the mapped file */
+    lv_display_set_color_format(disp, format);
+    lv_display_set_buffers(disp, map, NULL, size, LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_display_add_event_cb(disp, refresh_event_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(disp, refresh_event_cb, LV_EVENT_REFR_READY, NULL);
+
+    bbx_log(BBX_LOG_LEVEL_VERBOSE, "Rendering %ux%u pixels into %s", width, height, path);
+
+    return disp;
+}
+
+lv_color_format_t bbx_memory_display_find_format_with_name(const char *name) {
+    for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i) {
+        if (strcmp(formats[i].name, name) == 0) {
+            return formats[i].format;
+        }
+    }
+    return LV_COLOR_FORMAT_UNKNOWN;
+}
@@ -0,0 +1,34 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#ifndef BBX_MEMORY_DISPLAY_H
+#define BBX_MEMORY_DISPLAY_H
+
+#include "lvgl/lvgl.h"
+
+/**
+ * Create a headless display that renders into a memory-mapped file. The file contains the raw
+ * pixels of the most recent frame without any header and can be read by other processes while
+ * the display is running (e.g. from /dev/shm). In verbose mode, render and flush timings are
+ * logged for every frame.
+ *
+ * @param path path of the file to render into, the file is created or truncated
+ * @param width horizontal resolution in pixels
+ * @param height vertical resolution in pixels
+ * @param format pixel format
+ * @return the display or NULL on failure
+ */
+lv_display_t *bbx_memory_display_create(const char *path, uint32_t width, uint32_t height, lv_color_format_t format);
+
+/**
+ * Find the pixel format with a given name.
+ *
+ * @param name format name (rgb565, rgb888, xrgb8888 or argb8888)
+ * @return the pixel format or LV_COLOR_FORMAT_UNKNOWN if no format matched
+ */
+lv_color_format_t bbx_memory_display_find_format_with_name(const char *name);
+
+#endif /* BBX_MEMORY_DISPLAY_H */
@@ -0,0 +1,463 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#include "replay.h"
+
+#include "log.h"
+#include "tick.h"
+
+#include "lvgl/src/indev/lv_indev_private.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * Defines
+ */
+
+#define MAX_LINE_LENGTH 256
+
+
+/**
+ * Static variables
+ */
+
+typedef enum {
+    REPLAY_EVENT_TOUCH,
+    REPLAY_EVENT_POINTER,
+    REPLAY_EVENT_KEY
+} replay_event_type_t;
+
+typedef struct {
+    uint32_t time;
+    replay_event_type_t type;
+    lv_point_t point;
+    uint32_t key;
+    lv_indev_state_t state;
+} replay_event_t;
+
+static replay_event_t *events = NULL;
+static int num_events = 0;
+static int next_event = 0;
+static bool fast_replay = false;
+static uint32_t replay_start = 0;
+
+static lv_indev_t *pointer_indev = NULL;
+static lv_indev_t *keypad_indev = NULL;
+static lv_indev_data_t pointer_data;
+static lv_indev_data_t keypad_data;
+
+static uint64_t pending_since_us = 0;
+static uint32_t num_latency_samples = 0;
+static uint64_t min_latency_us = UINT64_MAX;
+static uint64_t max_latency_us = 0;
+static uint64_t sum_latency_us = 0;
+
+typedef struct {
+    lv_indev_read_cb_t read_cb;
+    bool is_touch;
+    lv_point_t point;
+    uint32_t key;
+    lv_indev_state_t state;
+} recorded_indev_t;
+
+static FILE *recording = NULL;
+static uint32_t recording_start = 0;
+
+
+/**
+ * Static prototypes
+ */
+
+/**
+ * Get the name of an event type as used in trace files.
+ *
+ * @param type event type
+ * @return the type's name
+ */
+static const char *event_type_to_str(replay_event_type_t type);
+
+/**
+ * Parse a single line of a trace file.
+ *
+ * @param line line to parse
+ * @param event pointer for writing the parsed event into
+ * @return true if the line contained an event, false otherwise
+ */
+static bool parse_event(const char *line, replay_event_t *event);
+
+/**
+ * Parse a trace file into the events array.
+ *
+ * @param path path of the trace file
+ * @return true if the file was parsed successfully, false otherwise
+ */
+static bool parse_trace(const char *path);
+
+/**
+ * Read callback for the replay input devices.
+ *
+ * @param indev input device
+ * @param data pointer for writing the current state into
+ */
+static void replay_read_cb(lv_indev_t *indev, lv_indev_data_t *data);
+
+/**
+ * Inject a single event into its input device.
+ *
+ * @param event the event to inject
+ */
+static void inject_event(const replay_event_t *event);
+
+/**
+ * Inject all due events and reschedule for the next one.
+ *
+ * @param timer the timer object
+ */
+static void replay_timer_cb(lv_timer_t *timer);
+
+/**
+ * Handle LV_EVENT_RENDER_READY events from the display and sample the input latency.
+ *
+ * @param event the event object
+ */
+static void render_ready_cb(lv_event_t *event);
+
+/**
+ * Log the latency summary and tear down the replay.
+ *
+ * @param timer the replay timer
+ */
+static void finish_replay(lv_timer_t *timer);
+
+/**
+ * Read callback for recorded input devices. Forwards to the original callback and writes state
+ * changes into the trace file.
+ *
+ * @param indev input device
+ * @param data pointer for writing the current state into
+ */
+static void record_read_cb(lv_indev_t *indev, lv_indev_data_t *data);
+
+/**
+ * Handle LV_EVENT_DELETE events from recorded input devices.
+ *
+ * @param event the event object
+ */
+static void recorded_indev_delete_cb(lv_event_t *event);
+
+
+/**
+ * Static functions
+ */
+
+static const char *event_type_to_str(replay_event_type_t type) {
+    switch (type) {
+        case REPLAY_EVENT_TOUCH:
+            return "touch";
+        case REPLAY_EVENT_POINTER:
+            return "pointer";
+        case REPLAY_EVENT_KEY:
+            return "key";
+        default:
+            return "unknown";
+    }
+}
+
+static bool parse_event(const char *line, replay_event_t *event) {
+    char type[16];
+    char state[16];
+    int offset = 0;
+
+    if (sscanf(line, "%" SCNu32 " %15s %n", &(event->time), type, &offset) != 2) {
+        return false;
+    }
+
+    if (strcmp(type, "touch") == 0 || strcmp(type, "pointer") == 0) {
+        event->type = type[0] == 't' ? REPLAY_EVENT_TOUCH : REPLAY_EVENT_POINTER;
+        int32_t x, y;
+        if (sscanf(line + offset, "%" SCNd32 " %" SCNd32 " %15s", &x, &y, state) != 3) {
+            return false;
+        }
+        event->point.x = x;
+        event->point.y = y;
+        event->key = 0;
+    } else if (strcmp(type, "key") == 0) {
+        event->type = REPLAY_EVENT_KEY;
+        if (sscanf(line + offset, "%" SCNu32 " %15s", &(event->key), state) != 2) {
+            return false;
+        }
+        event->point.x = 0;
+        event->point.y = 0;
+    } else {
+        return false;
+    }
+
+    if (strcmp(state, "pressed") == 0) {
+        event->state = LV_INDEV_STATE_PRESSED;
+    } else if (strcmp(state, "released") == 0) {
+        event->state = LV_INDEV_STATE_RELEASED;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+static bool parse_trace(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not open input trace %s: %s", path, strerror(errno));
+        return false;
+    }
+
+    int capacity = 0;
+    int line_number = 0;
+    char line[MAX_LINE_LENGTH];
+
+    while (fgets(line, sizeof(line), file)) {
+        ++line_number;
+
+        const char *start = line + strspn(line, " \t");
+        if (*start == '#' || *start == '\n' || *start == '\0') {
+            continue;
+        }
+
+        /* Double array size every time it's filled */
+        if (num_events == capacity) {
+            replay_event_t *tmp = realloc(events, (2 * capacity + 1) * sizeof(replay_event_t));
+            if (!tmp) {
+                bbx_log(BBX_LOG_LEVEL_ERROR, "Could not reallocate memory for input trace");
+                fclose(file);
+                return false;
+            }
+            events = tmp;
+            capacity = 2 * capacity + 1;
+        }
+
+        replay_event_t *event = &events[num_events];
+        if (!parse_event(start, event)) {
+            bbx_log(BBX_LOG_LEVEL_WARNING, "Ignoring invalid event on line %d of input trace %s", line_number, path);
+            continue;
+        }
+
+        if (num_events > 0 && event->time < events[num_events - 1].time) {
+            bbx_log(BBX_LOG_LEVEL_WARNING, "Ignoring out-of-order event on line %d of input trace %s", line_number, path);
+            continue;
+        }
+
+        ++num_events;
+    }
+
+    fclose(file);
+    return true;
+}
+
+static void replay_read_cb(lv_indev_t *indev, lv_indev_data_t *data) {
+    const lv_indev_data_t *current = indev == pointer_indev ? &pointer_data : &keypad_data;
+    data->point = current->point;
+    data->key = current->key;
+    data->state = current->state;
+}
+
+static void inject_event(const replay_event_t *event) {
+    lv_indev_t *indev = NULL;
+
+    if (event->type == REPLAY_EVENT_KEY) {
+        keypad_data.key = event->key;
+        keypad_data.state = event->state;
+        indev = keypad_indev;
+    } else {
+        pointer_data.point = event->point;
+        pointer_data.state = event->state;
+        indev = pointer_indev;
+    }
+
+    /* Measure from the oldest input that hasn't been rendered yet */
+    if (pending_since_us == 0) {
+        pending_since_us = bbx_tick_get_us();
+    }
+
+    lv_indev_read(indev);
+}
+
+static void replay_timer_cb(lv_timer_t *timer) {
+    uint32_t elapsed = lv_tick_elaps(replay_start);
+
+    while (next_event < num_events) {
+        const replay_event_t *event = &events[next_event];
+        if (!fast_replay && event->time > elapsed) {
+            break;
+        }
+
+        inject_event(event);
+        ++next_event;
+
+        /* Give LVGL a chance to run its other timers between events */
+        if (fast_replay) {
+            break;
+        }
+    }
+
+    if (next_event == num_events) {
+        finish_replay(timer);
+        return;
+    }
+
+    lv_timer_set_period(timer, fast_replay ? 1 : events[next_event].time - elapsed);
+}
+
+static void render_ready_cb(lv_event_t *event) {
+    LV_UNUSED(event);
+
+    if (pending_since_us == 0) {
+        return;
+    }
+
+    uint64_t latency_us = bbx_tick_get_us() - pending_since_us;
+    pending_since_us = 0;
+
+    ++num_latency_samples;
+    sum_latency_us += latency_us;
+    min_latency_us = LV_MIN(min_latency_us, latency_us);
+    max_latency_us = LV_MAX(max_latency_us, latency_us);
+}
+
+static void finish_replay(lv_timer_t *timer) {
+    lv_timer_delete(timer);
+
+    if (num_latency_samples == 0) {
+        bbx_log(BBX_LOG_LEVEL_VERBOSE, "Replay finished: %d events, no frames rendered", num_events);
+        return;
+    }
+
+    bbx_log(BBX_LOG_LEVEL_VERBOSE, "Replay finished: %d events in %u ms, %u frames, latency min %.2f ms, avg %.2f ms, max %.2f ms",
+        num_events, lv_tick_elaps(replay_start), num_latency_samples, min_latency_us / 1000.0,
+        sum_latency_us / 1000.0 / num_latency_samples, max_latency_us / 1000.0);
+}
+
+static void record_read_cb(lv_indev_t *indev, lv_indev_data_t *data) {
+    recorded_indev_t *recorded = lv_indev_get_user_data(indev);
+    recorded->read_cb(indev, data);
+
+    if (!recording) {
+        return;
+    }
+
+    uint32_t time = lv_tick_elaps(recording_start);
+    const char *state = data->state == LV_INDEV_STATE_PRESSED ? "pressed" : "released";
+
+    if (lv_indev_get_type(indev) == LV_INDEV_TYPE_KEYPAD) {
+        if (data->key == recorded->key && data->state == recorded->state) {
+            return;
+        }
+        fprintf(recording, "%" PRIu32 " key %" PRIu32 " %s\n", time, data->key, state);
+    } else {
+        if (data->point.x == recorded->point.x && data->point.y == recorded->point.y && data->state == recorded->state) {
+            return;
+        }
+        fprintf(recording, "%" PRIu32 " %s %" PRId32 " %" PRId32 " %s\n", time,
+            event_type_to_str(recorded->is_touch ? REPLAY_EVENT_TOUCH : REPLAY_EVENT_POINTER),
+            (int32_t)data->point.x, (int32_t)data->point.y, state);
+    }
+
+    recorded->point = data->point;
+    recorded->key = data->key;
+    recorded->state = data->state;
+}
+
+static void recorded_indev_delete_cb(lv_event_t *event) {
+    lv_indev_t *indev = lv_event_get_target(event);
+    free(lv_indev_get_user_data(indev));
+    lv_indev_set_user_data(indev, NULL);
+}
+
+
+/**
+ * Public functions
+ */
+
+bool bbx_replay_start(const char *path, bool fast, lv_group_t *keyboard_input_group) {
+    if (!parse_trace(path)) {
+        return false;
+    }
+
+    if (num_events == 0) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Input trace %s doesn't contain any events", path);
+        return false;
+    }
+
+    lv_memzero(&pointer_data, sizeof(pointer_data));
+    lv_memzero(&keypad_data, sizeof(keypad_data));
+
+    /* Inject events on demand rather than polling the devices */
+    pointer_indev = lv_indev_create();
+    lv_indev_set_type(pointer_indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(pointer_indev, replay_read_cb);
+    lv_indev_set_mode(pointer_indev, LV_INDEV_MODE_EVENT);
+
+    keypad_indev = lv_indev_create();
+    lv_indev_set_type(keypad_indev, LV_INDEV_TYPE_KEYPAD);
+    lv_indev_set_read_cb(keypad_indev, replay_read_cb);
+    lv_indev_set_mode(keypad_indev, LV_INDEV_MODE_EVENT);
+    if (keyboard_input_group) {
+        lv_indev_set_group(keypad_indev, keyboard_input_group);
+    }
+
+    lv_display_add_event_cb(lv_display_get_default(), render_ready_cb, LV_EVENT_RENDER_READY, NULL);
+
+    fast_replay = fast;
+    next_event = 0;
+    replay_start = lv_tick_get();
+    lv_timer_create(replay_timer_cb, fast ? 1 : events[0].time, NULL);
+
+    bbx_log(BBX_LOG_LEVEL_VERBOSE, "Replaying %d events from %s%s", num_events, path, fast ? " as fast as possible" : "");
+
+    return true;
+}
+
+bool bbx_replay_start_recording(const char *path) {
+    recording = fopen(path, "w");
+    if (!recording) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not open input trace %s: %s", path, strerror(errno));
+        return false;
+    }
+
+    /* Flush every line so that the trace survives the process being killed */
+    setvbuf(recording, NULL, _IOLBF, 0);
+
+    fprintf(recording, "# <time> touch|pointer <x> <y> pressed|released\n");
+    fprintf(recording, "# <time> key <code> pressed|released\n");
+    recording_start = lv_tick_get();
+
+    bbx_log(BBX_LOG_LEVEL_VERBOSE, "Recording input events into %s", path);
+
+    return true;
+}
+
+void bbx_replay_record_indev(lv_indev_t *indev, bool is_touch) {
+    if (!recording) {
+        return;
+    }
+
+    recorded_indev_t *recorded = malloc(sizeof(recorded_indev_t));
+    if (!recorded) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not allocate memory for recorded input device");
+        return;
+    }
+    lv_memzero(recorded, sizeof(recorded_indev_t));
+    recorded->read_cb = indev->read_cb;
+    recorded->is_touch = is_touch;
+    recorded->state = LV_INDEV_STATE_RELEASED;
+
+    lv_indev_set_user_data(indev, recorded);
+    lv_indev_set_read_cb(indev, record_read_cb);
+    lv_indev_add_event_cb(indev, recorded_indev_delete_cb, LV_EVENT_DELETE, NULL);
+}
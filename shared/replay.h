@@ -0,0 +1,57 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#ifndef BBX_REPLAY_H
+#define BBX_REPLAY_H
+
+#include "lvgl/lvgl.h"
+
+#include <stdbool.h>
+
+/**
+ * Input traces are line-based text files. Empty lines and lines starting with '#' are ignored.
+ * Every other line describes one input event:
+ *
+ *   <time> touch <x> <y> <pressed|released>
+ *   <time> pointer <x> <y> <pressed|released>
+ *   <time> key <code> <pressed|released>
+ *
+ * where time is the number of milliseconds since the start of the trace, x and y are display
+ * coordinates and code is the LVGL key code (i.e. the Unicode code point or one of LV_KEY_*).
+ * Events have to be sorted by time.
+ */
+
+/**
+ * Start replaying an input trace. Touch and pointer events are injected through a pointer input
+ * device, key events through a keypad input device. While the replay is running, the latency
+ * between injecting an event and the end of the next render pass is measured. A summary is logged
+ * once the trace has been fully replayed.
+ *
+ * @param path path of the trace file
+ * @param fast if true, ignore the recorded timestamps and inject events as fast as possible
+ * @param keyboard_input_group group that should receive key events or NULL
+ * @return true if the replay was started successfully, false otherwise
+ */
+bool bbx_replay_start(const char *path, bool fast, lv_group_t *keyboard_input_group);
+
+/**
+ * Start recording input events into a trace file. Only input devices that are registered
+ * afterwards via bbx_replay_record_indev are recorded.
+ *
+ * @param path path of the trace file, the file is created or truncated
+ * @return true if the recording was started successfully, false otherwise
+ */
+bool bbx_replay_start_recording(const char *path);
+
+/**
+ * Record the events read from an input device if a recording was started. Has no effect otherwise.
+ *
+ * @param indev input device
+ * @param is_touch if true and indev is a pointer device, record events as touch events
+ */
+void bbx_replay_record_indev(lv_indev_t *indev, bool is_touch);
+
+#endif /* BBX_REPLAY_H */
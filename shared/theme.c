@@ -12,14 +12,30 @@
 #include "lvgl/lvgl.h"
 
 
+/**
+ * Defines
+ */
+
+/* Combine the control bits that determine a key's class into an index between 0 and 7 */
+#define KEY_CTRL_INDEX(ctrl) ( \
+      (((ctrl) & LV_BUTTONMATRIX_CTRL_CHECKABLE) != 0) \
+    | ((((ctrl) & LV_BUTTONMATRIX_CTRL_CHECKED) != 0) << 1) \
+    | ((((ctrl) & LV_BUTTONMATRIX_CTRL_CLICK_TRIG) != 0) << 2))
+#define NUM_KEY_CTRL_INDEXES 8
+
+#define MAX_STYLE_SETS 2 /* Enough for a default and an alternate theme */
+
+#define MAX_RULE_STYLES 3
+#define RULE_TABLE_SIZE 64 /* Needs to be a power of two and larger than the number of rules */
+
+
 /**
  * Static variables
  */
 
-static bbx_theme current_theme;
 static lv_theme_t lv_theme;
 
-static struct {
+struct styles {
     lv_style_t widget;
     lv_style_t window;
     lv_style_t header;
@@ -40,9 +56,97 @@ static struct {
     lv_style_t msgbox_background;
     lv_style_t bar;
     lv_style_t bar_indicator;
-} styles; 
-
-static bool are_styles_initialised = false;
+};
+
+/* Styles attached to widgets. These are shallow copies of the current style set's styles. */
+static struct styles styles;
+
+enum key_class {
+    KEY_CLASS_CHAR = 0,
+    KEY_CLASS_NON_CHAR,
+    KEY_CLASS_MOD_ACTIVE,
+    KEY_CLASS_MOD_INACTIVE,
+    NUM_KEY_CLASSES
+};
+
+/* Ready-to-use colors of a key in a specific state */
+struct key_colors {
+    lv_color_t fg_color;
+    lv_color_t bg_color;
+    lv_color_t border_color;
+};
+
+static uint8_t key_classes[NUM_KEY_CTRL_INDEXES]; /* Indexed by KEY_CTRL_INDEX */
+static bool are_key_classes_initialised = false;
+
+/* Prebuilt styles and key colors for a theme */
+struct style_set {
+    const bbx_theme *theme; /* NULL if the set is unused */
+    bool are_styles_initialised;
+    struct styles styles;
+    struct key_colors key_colors[NUM_KEY_CLASSES][2]; /* Indexed by key class and pressed state */
+};
+
+static struct style_set style_sets[MAX_STYLE_SETS];
+static struct style_set *current_style_set = NULL;
+
+/* Styles to add to objects of a specific class and, optionally, with a parent of a specific class */
+struct style_rule {
+    const lv_obj_class_t *class_p;
+    const lv_obj_class_t *parent_class_p; /* NULL to match any parent */
+    struct {
+        lv_style_t *style;
+        lv_style_selector_t selector;
+    } styles[MAX_RULE_STYLES]; /* Terminated by a NULL style if less than MAX_RULE_STYLES are used */
+};
+
+/* Rules without any styles make objects inherit the styling of their parent */
+static const struct style_rule style_rules[] = {
+    { &lv_keyboard_class, NULL, {
+        { &(styles.keyboard), 0 },
+        { &(styles.key), LV_PART_ITEMS } } },
+    { &lv_button_class, NULL, {
+        { &(styles.button), 0 },
+        { &(styles.button_pressed), LV_STATE_PRESSED } } },
+    { &lv_textarea_class, NULL, {
+        { &(styles.textarea), 0 },
+        { &(styles.textarea_placeholder), LV_PART_TEXTAREA_PLACEHOLDER },
+        { &(styles.textarea_cursor), LV_PART_CURSOR | LV_STATE_FOCUSED } } },
+    { &lv_dropdown_class, NULL, {
+        { &(styles.dropdown), 0 },
+        { &(styles.dropdown_pressed), LV_STATE_PRESSED } } },
+    { &lv_dropdownlist_class, NULL, {
+        { &(styles.dropdown_list), 0 },
+        { &(styles.dropdown_list_selected), LV_PART_SELECTED | LV_STATE_CHECKED },
+        { &(styles.dropdown_list_selected), LV_PART_SELECTED | LV_STATE_PRESSED } } },
+    { &lv_msgbox_class, NULL, {
+        { &(styles.msgbox), 0 } } },
+    { &lv_msgbox_footer_button_class, NULL, {
+        { &(styles.button), 0 },
+        { &(styles.button_pressed), LV_STATE_PRESSED } } },
+    { &lv_msgbox_backdrop_class, NULL, {
+        { &(styles.msgbox_background), 0 } } },
+    { &lv_bar_class, NULL, {
+        { &(styles.bar), 0 },
+        { &(styles.bar_indicator), LV_PART_INDICATOR } } },
+    { &lv_spangroup_class, NULL, {
+        { &(styles.label), 0 } } },
+    { &lv_label_class, NULL, {
+        { &(styles.label), 0 } } },
+    { &lv_label_class, &lv_button_class, { { NULL } } },
+    { &lv_label_class, &lv_textarea_class, { { NULL } } },
+    { &lv_label_class, &lv_dropdownlist_class, { { NULL } } },
+    { &lv_label_class, &lv_msgbox_class, {
+        { &(styles.msgbox_label), 0 } } },
+    { &lv_label_class, &lv_msgbox_header_class, {
+        { &(styles.msgbox_label), 0 } } },
+    { &lv_label_class, &lv_msgbox_content_class, {
+        { &(styles.msgbox_label), 0 } } }
+};
+
+/* Open-addressing hash table of style_rules, keyed by class and parent class */
+static const struct style_rule *rule_table[RULE_TABLE_SIZE];
+static bool is_rule_table_initialised = false;
 
 
 /**
@@ -50,18 +154,64 @@ static bool are_styles_initialised = false;
  */
 
 /**
- * Set up the static styles for a specific theme.
+ * Set up the lookup table that maps control bits to key classes.
+ */
+static void init_key_classes(void);
+
+/**
+ * Convert the colors of a key state into their LVGL representation.
+ *
+ * @param state key state
+ * @param colors destination colors
+ */
+static void init_key_colors(const bbx_theme_key_state *state, struct key_colors *colors);
+
+/**
+ * Set up the styles and key colors of a style set for a specific theme.
  *
  * @param theme theme to derive the styles from
+ * @param set style set to populate
  */
-static void init_styles(const bbx_theme *theme);
+static void init_styles(const bbx_theme *theme, struct style_set *set);
 
 /**
  * Initialise or reset a style.
  *
  * @param style style to reset
+ * @param is_initialised true if the style was initialised before
+ */
+static void reset_style(lv_style_t *style, bool is_initialised);
+
+/**
+ * Find the style set for a theme, building it if it doesn't exist yet.
+ *
+ * @param theme theme to find the style set for
+ * @return the style set
  */
-static void reset_style(lv_style_t *style);
+static struct style_set *get_style_set(const bbx_theme *theme);
+
+/**
+ * Compute the slot in the rule table at which to start looking for a rule.
+ *
+ * @param class_p object class
+ * @param parent_class_p parent object class or NULL
+ * @return slot index
+ */
+static uint32_t get_rule_table_slot(const lv_obj_class_t *class_p, const lv_obj_class_t *parent_class_p);
+
+/**
+ * Populate the rule table from style_rules.
+ */
+static void init_rule_table(void);
+
+/**
+ * Find the rule for a specific class and parent class in the rule table.
+ *
+ * @param class_p object class
+ * @param parent_class_p parent object class or NULL for rules that match any parent
+ * @return the rule or NULL if no rule matched
+ */
+static const struct style_rule *find_rule(const lv_obj_class_t *class_p, const lv_obj_class_t *parent_class_p);
 
 /**
  * Apply a theme to an object.
@@ -83,243 +233,264 @@ static void keyboard_draw_task_added_cb(lv_event_t *event);
  * Static functions
  */
 
-static void init_styles(const bbx_theme *theme) {
-    reset_style(&(styles.widget));
-    lv_style_set_text_font(&(styles.widget), &bbx_font_32);
-
-    reset_style(&(styles.window));
-    lv_style_set_bg_opa(&(styles.window), LV_OPA_COVER);
-    lv_style_set_bg_color(&(styles.window), lv_color_hex(theme->window.bg_color));
-
-    reset_style(&(styles.header));
-    lv_style_set_bg_opa(&(styles.header), LV_OPA_COVER);
-    lv_style_set_bg_color(&(styles.header), lv_color_hex(theme->header.bg_color));
-    lv_style_set_border_side(&(styles.header), LV_BORDER_SIDE_BOTTOM);
-    lv_style_set_border_width(&(styles.header), lv_dpx(theme->header.border_width));
-    lv_style_set_border_color(&(styles.header), lv_color_hex(theme->header.border_color));
-    lv_style_set_pad_all(&(styles.header), lv_dpx(theme->header.pad));
-    lv_style_set_pad_gap(&(styles.header), lv_dpx(theme->header.gap));
-
-    reset_style(&(styles.keyboard));
-    lv_style_set_bg_opa(&(styles.keyboard), LV_OPA_COVER);
-    lv_style_set_bg_color(&(styles.keyboard), lv_color_hex(theme->keyboard.bg_color));
-    lv_style_set_border_side(&(styles.keyboard), LV_BORDER_SIDE_TOP);
-    lv_style_set_border_width(&(styles.keyboard), lv_dpx(theme->keyboard.border_width));
-    lv_style_set_border_color(&(styles.keyboard), lv_color_hex(theme->keyboard.border_color));
-    lv_style_set_pad_all(&(styles.keyboard), lv_dpx(theme->keyboard.pad));
-    lv_style_set_pad_gap(&(styles.keyboard), lv_dpx(theme->keyboard.gap));
-
-    reset_style(&(styles.key));
-    lv_style_set_bg_opa(&(styles.key), LV_OPA_COVER);
-    lv_style_set_border_side(&(styles.key), LV_BORDER_SIDE_FULL);
-    lv_style_set_border_width(&(styles.key), lv_dpx(theme->keyboard.keys.border_width));
-    lv_style_set_radius(&(styles.key), lv_dpx(theme->keyboard.keys.corner_radius));
-
-    reset_style(&(styles.button));
-    lv_style_set_text_color(&(styles.button), lv_color_hex(theme->button.normal.fg_color));
-    lv_style_set_bg_opa(&(styles.button), LV_OPA_COVER);
-    lv_style_set_bg_color(&(styles.button), lv_color_hex(theme->button.normal.bg_color));
-    lv_style_set_border_side(&(styles.button), LV_BORDER_SIDE_FULL);
-    lv_style_set_border_width(&(styles.button), lv_dpx(theme->button.border_width));
-    lv_style_set_border_color(&(styles.button), lv_color_hex(theme->button.normal.border_color));
-    lv_style_set_radius(&(styles.button), lv_dpx(theme->button.corner_radius));
-    lv_style_set_pad_all(&(styles.button), lv_dpx(theme->button.pad));
-
-    reset_style(&(styles.button_pressed));
-    lv_style_set_text_color(&(styles.button_pressed), lv_color_hex(theme->button.pressed.fg_color));
-    lv_style_set_bg_color(&(styles.button_pressed), lv_color_hex(theme->button.pressed.bg_color));
-    lv_style_set_border_color(&(styles.button_pressed), lv_color_hex(theme->button.pressed.border_color));
-
-    reset_style(&(styles.textarea));
-    lv_style_set_text_color(&(styles.textarea), lv_color_hex(theme->textarea.fg_color));
-    lv_style_set_bg_opa(&(styles.textarea), LV_OPA_COVER);
-    lv_style_set_bg_color(&(styles.textarea), lv_color_hex(theme->textarea.bg_color));  
-    lv_style_set_border_side(&(styles.textarea), LV_BORDER_SIDE_FULL);
-    lv_style_set_border_width(&(styles.textarea), lv_dpx(theme->textarea.border_width));
-    lv_style_set_border_color(&(styles.textarea), lv_color_hex(theme->textarea.border_color));
-    lv_style_set_radius(&(styles.textarea), lv_dpx(theme->textarea.corner_radius));
-    lv_style_set_pad_all(&(styles.textarea), lv_dpx(theme->textarea.pad));
-
-    reset_style(&(styles.textarea_placeholder));
-    lv_style_set_text_color(&(styles.textarea_placeholder), lv_color_hex(theme->textarea.placeholder_color));
-
-    reset_style(&(styles.textarea_cursor));
-    lv_style_set_border_side(&(styles.textarea_cursor), LV_BORDER_SIDE_LEFT);
-    lv_style_set_border_width(&(styles.textarea_cursor), lv_dpx(theme->textarea.cursor.width));
-    lv_style_set_border_color(&(styles.textarea_cursor), lv_color_hex(theme->textarea.cursor.color));
-    lv_style_set_anim_time(&(styles.textarea_cursor), theme->textarea.cursor.period);
-
-    reset_style(&(styles.dropdown));
-    lv_style_set_text_color(&(styles.dropdown), lv_color_hex(theme->dropdown.button.normal.fg_color));
-    lv_style_set_bg_opa(&(styles.dropdown), LV_OPA_COVER);
-    lv_style_set_bg_color(&(styles.dropdown), lv_color_hex(theme->dropdown.button.normal.bg_color));
-    lv_style_set_border_side(&(styles.dropdown), LV_BORDER_SIDE_FULL);
-    lv_style_set_border_width(&(styles.dropdown), lv_dpx(theme->dropdown.button.border_width));
-    lv_style_set_border_color(&(styles.dropdown), lv_color_hex(theme->dropdown.button.normal.border_color));
-    lv_style_set_radius(&(styles.dropdown), lv_dpx(theme->dropdown.button.corner_radius));
-    lv_style_set_pad_all(&(styles.dropdown), lv_dpx(theme->dropdown.button.pad));
-
-    reset_style(&(styles.dropdown_pressed));
-    lv_style_set_text_color(&(styles.dropdown_pressed), lv_color_hex(theme->dropdown.button.pressed.fg_color));
-    lv_style_set_bg_color(&(styles.dropdown_pressed), lv_color_hex(theme->dropdown.button.pressed.bg_color));
-    lv_style_set_border_color(&(styles.dropdown_pressed), lv_color_hex(theme->dropdown.button.pressed.border_color));
-
-    reset_style(&(styles.dropdown_list));
-    lv_style_set_text_color(&(styles.dropdown_list), lv_color_hex(theme->dropdown.list.fg_color));
-    lv_style_set_bg_opa(&(styles.dropdown_list), LV_OPA_COVER);
-    lv_style_set_bg_color(&(styles.dropdown_list), lv_color_hex(theme->dropdown.list.bg_color));
-    lv_style_set_border_side(&(styles.dropdown_list), LV_BORDER_SIDE_FULL);
-    lv_style_set_border_width(&(styles.dropdown_list), lv_dpx(theme->dropdown.list.border_width));
-    lv_style_set_border_color(&(styles.dropdown_list), lv_color_hex(theme->dropdown.list.border_color));
-    lv_style_set_radius(&(styles.dropdown_list), lv_dpx(theme->dropdown.list.corner_radius));
-    lv_style_set_pad_all(&(styles.dropdown_list), lv_dpx(theme->dropdown.list.pad));
-
-    reset_style(&(styles.dropdown_list_selected));
-    lv_style_set_text_color(&(styles.dropdown_list_selected), lv_color_hex(theme->dropdown.list.selection_fg_color));
-    lv_style_set_bg_opa(&(styles.dropdown_list_selected), LV_OPA_COVER);
-    lv_style_set_bg_color(&(styles.dropdown_list_selected), lv_color_hex(theme->dropdown.list.selection_bg_color));
-
-    reset_style(&(styles.label));
-    lv_style_set_text_color(&(styles.label), lv_color_hex(theme->label.fg_color));
-
-    reset_style(&(styles.msgbox));
-    lv_style_set_text_color(&(styles.msgbox), lv_color_hex(theme->msgbox.fg_color));
-    lv_style_set_bg_opa(&(styles.msgbox), LV_OPA_COVER);
-    lv_style_set_bg_color(&(styles.msgbox), lv_color_hex(theme->msgbox.bg_color));
-    lv_style_set_border_side(&(styles.msgbox), LV_BORDER_SIDE_FULL);
-    lv_style_set_border_width(&(styles.msgbox), lv_dpx(theme->msgbox.border_width));
-    lv_style_set_border_color(&(styles.msgbox), lv_color_hex(theme->msgbox.border_color));
-    lv_style_set_radius(&(styles.msgbox), lv_dpx(theme->msgbox.corner_radius));
-    lv_style_set_pad_all(&(styles.msgbox), lv_dpx(theme->msgbox.pad));
-
-    reset_style(&(styles.msgbox_label));
-    lv_style_set_text_align(&(styles.msgbox_label), LV_TEXT_ALIGN_CENTER);
-    lv_style_set_pad_bottom(&(styles.msgbox_label), lv_dpx(theme->msgbox.gap));
-
-    reset_style(&(styles.msgbox_background));
-    lv_style_set_bg_color(&(styles.msgbox_background), lv_color_hex(theme->msgbox.dimming.color));
-    lv_style_set_bg_opa(&(styles.msgbox_background), theme->msgbox.dimming.opacity);
-
-    reset_style(&(styles.bar));
-    lv_style_set_border_side(&(styles.bar), LV_BORDER_SIDE_FULL);
-    lv_style_set_border_width(&(styles.bar), lv_dpx(theme->bar.border_width));
-    lv_style_set_border_color(&(styles.bar), lv_color_hex(theme->bar.border_color));
-    lv_style_set_radius(&(styles.bar), lv_dpx(theme->bar.corner_radius));
-
-    reset_style(&(styles.bar_indicator));
-    lv_style_set_bg_opa(&(styles.bar_indicator), LV_OPA_COVER);
-    lv_style_set_bg_color(&(styles.bar_indicator), lv_color_hex(theme->bar.indicator.bg_color));
-
-    are_styles_initialised = true;
+static void init_key_classes(void) {
+    for (int i = 0; i < NUM_KEY_CTRL_INDEXES; ++i) {
+        lv_buttonmatrix_ctrl_t ctrl = 0;
+        ctrl |= (i & 1) ? LV_BUTTONMATRIX_CTRL_CHECKABLE : 0;
+        ctrl |= (i & 2) ? LV_BUTTONMATRIX_CTRL_CHECKED : 0;
+        ctrl |= (i & 4) ? LV_BUTTONMATRIX_CTRL_CLICK_TRIG : 0;
+
+        if ((ctrl & SQ2LV_CTRL_MOD_INACTIVE) == SQ2LV_CTRL_MOD_INACTIVE) {
+            key_classes[i] = KEY_CLASS_MOD_INACTIVE;
+        } else if ((ctrl & SQ2LV_CTRL_MOD_ACTIVE) == SQ2LV_CTRL_MOD_ACTIVE) {
+            key_classes[i] = KEY_CLASS_MOD_ACTIVE;
+        } else if ((ctrl & SQ2LV_CTRL_NON_CHAR) == SQ2LV_CTRL_NON_CHAR) {
+            key_classes[i] = KEY_CLASS_NON_CHAR;
+        } else {
+            key_classes[i] = KEY_CLASS_CHAR;
+        }
+    }
+
+    are_key_classes_initialised = true;
+}
+
+static void init_key_colors(const bbx_theme_key_state *state, struct key_colors *colors) {
+    colors->fg_color = state->fg_color;
+    colors->bg_color = state->bg_color;
+    colors->border_color = state->border_color;
+}
+
+static void init_styles(const bbx_theme *theme, struct style_set *set) {
+    reset_style(&(set->styles.widget), set->are_styles_initialised);
+    lv_style_set_text_font(&(set->styles.widget), &bbx_font_32);
+
+    reset_style(&(set->styles.window), set->are_styles_initialised);
+    lv_style_set_bg_opa(&(set->styles.window), LV_OPA_COVER);
+    lv_style_set_bg_color(&(set->styles.window), theme->window.bg_color);
+
+    reset_style(&(set->styles.header), set->are_styles_initialised);
+    lv_style_set_bg_opa(&(set->styles.header), LV_OPA_COVER);
+    lv_style_set_bg_color(&(set->styles.header), theme->header.bg_color);
+    lv_style_set_border_side(&(set->styles.header), LV_BORDER_SIDE_BOTTOM);
+    lv_style_set_border_width(&(set->styles.header), lv_dpx(theme->header.border_width));
+    lv_style_set_border_color(&(set->styles.header), theme->header.border_color);
+    lv_style_set_pad_all(&(set->styles.header), lv_dpx(theme->header.pad));
+    lv_style_set_pad_gap(&(set->styles.header), lv_dpx(theme->header.gap));
+
+    reset_style(&(set->styles.keyboard), set->are_styles_initialised);
+    lv_style_set_bg_opa(&(set->styles.keyboard), LV_OPA_COVER);
+    lv_style_set_bg_color(&(set->styles.keyboard), theme->keyboard.bg_color);
+    lv_style_set_border_side(&(set->styles.keyboard), LV_BORDER_SIDE_TOP);
+    lv_style_set_border_width(&(set->styles.keyboard), lv_dpx(theme->keyboard.border_width));
+    lv_style_set_border_color(&(set->styles.keyboard), theme->keyboard.border_color);
+    lv_style_set_pad_all(&(set->styles.keyboard), lv_dpx(theme->keyboard.pad));
+    lv_style_set_pad_gap(&(set->styles.keyboard), lv_dpx(theme->keyboard.gap));
+
+    reset_style(&(set->styles.key), set->are_styles_initialised);
+    lv_style_set_bg_opa(&(set->styles.key), LV_OPA_COVER);
+    lv_style_set_border_side(&(set->styles.key), LV_BORDER_SIDE_FULL);
+    lv_style_set_border_width(&(set->styles.key), lv_dpx(theme->keyboard.keys.border_width));
+    lv_style_set_radius(&(set->styles.key), lv_dpx(theme->keyboard.keys.corner_radius));
+
+    reset_style(&(set->styles.button), set->are_styles_initialised);
+    lv_style_set_text_color(&(set->styles.button), theme->button.normal.fg_color);
+    lv_style_set_bg_opa(&(set->styles.button), LV_OPA_COVER);
+    lv_style_set_bg_color(&(set->styles.button), theme->button.normal.bg_color);
+    lv_style_set_border_side(&(set->styles.button), LV_BORDER_SIDE_FULL);
+    lv_style_set_border_width(&(set->styles.button), lv_dpx(theme->button.border_width));
+    lv_style_set_border_color(&(set->styles.button), theme->button.normal.border_color);
+    lv_style_set_radius(&(set->styles.button), lv_dpx(theme->button.corner_radius));
+    lv_style_set_pad_all(&(set->styles.button), lv_dpx(theme->button.pad));
+
+    reset_style(&(set->styles.button_pressed), set->are_styles_initialised);
+    lv_style_set_text_color(&(set->styles.button_pressed), theme->button.pressed.fg_color);
+    lv_style_set_bg_color(&(set->styles.button_pressed), theme->button.pressed.bg_color);
+    lv_style_set_border_color(&(set->styles.button_pressed), theme->button.pressed.border_color);
+
+    reset_style(&(set->styles.textarea), set->are_styles_initialised);
+    lv_style_set_text_color(&(set->styles.textarea), theme->textarea.fg_color);
+    lv_style_set_bg_opa(&(set->styles.textarea), LV_OPA_COVER);
+    lv_style_set_bg_color(&(set->styles.textarea), theme->textarea.bg_color);  
+    lv_style_set_border_side(&(set->styles.textarea), LV_BORDER_SIDE_FULL);
+    lv_style_set_border_width(&(set->styles.textarea), lv_dpx(theme->textarea.border_width));
+    lv_style_set_border_color(&(set->styles.textarea), theme->textarea.border_color);
+    lv_style_set_radius(&(set->styles.textarea), lv_dpx(theme->textarea.corner_radius));
+    lv_style_set_pad_all(&(set->styles.textarea), lv_dpx(theme->textarea.pad));
+
+    reset_style(&(set->styles.textarea_placeholder), set->are_styles_initialised);
+    lv_style_set_text_color(&(set->styles.textarea_placeholder), theme->textarea.placeholder_color);
+
+    reset_style(&(set->styles.textarea_cursor), set->are_styles_initialised);
+    lv_style_set_border_side(&(set->styles.textarea_cursor), LV_BORDER_SIDE_LEFT);
+    lv_style_set_border_width(&(set->styles.textarea_cursor), lv_dpx(theme->textarea.cursor.width));
+    lv_style_set_border_color(&(set->styles.textarea_cursor), theme->textarea.cursor.color);
+    lv_style_set_anim_time(&(set->styles.textarea_cursor), theme->textarea.cursor.period);
+
+    reset_style(&(set->styles.dropdown), set->are_styles_initialised);
+    lv_style_set_text_color(&(set->styles.dropdown), theme->dropdown.button.normal.fg_color);
+    lv_style_set_bg_opa(&(set->styles.dropdown), LV_OPA_COVER);
+    lv_style_set_bg_color(&(set->styles.dropdown), theme->dropdown.button.normal.bg_color);
+    lv_style_set_border_side(&(set->styles.dropdown), LV_BORDER_SIDE_FULL);
+    lv_style_set_border_width(&(set->styles.dropdown), lv_dpx(theme->dropdown.button.border_width));
+    lv_style_set_border_color(&(set->styles.dropdown), theme->dropdown.button.normal.border_color);
+    lv_style_set_radius(&(set->styles.dropdown), lv_dpx(theme->dropdown.button.corner_radius));
+    lv_style_set_pad_all(&(set->styles.dropdown), lv_dpx(theme->dropdown.button.pad));
+
+    reset_style(&(set->styles.dropdown_pressed), set->are_styles_initialised);
+    lv_style_set_text_color(&(set->styles.dropdown_pressed), theme->dropdown.button.pressed.fg_color);
+    lv_style_set_bg_color(&(set->styles.dropdown_pressed), theme->dropdown.button.pressed.bg_color);
+    lv_style_set_border_color(&(set->styles.dropdown_pressed), theme->dropdown.button.pressed.border_color);
+
+    reset_style(&(set->styles.dropdown_list), set->are_styles_initialised);
+    lv_style_set_text_color(&(set->styles.dropdown_list), theme->dropdown.list.fg_color);
+    lv_style_set_bg_opa(&(set->styles.dropdown_list), LV_OPA_COVER);
+    lv_style_set_bg_color(&(set->styles.dropdown_list), theme->dropdown.list.bg_color);
+    lv_style_set_border_side(&(set->styles.dropdown_list), LV_BORDER_SIDE_FULL);
+    lv_style_set_border_width(&(set->styles.dropdown_list), lv_dpx(theme->dropdown.list.border_width));
+    lv_style_set_border_color(&(set->styles.dropdown_list), theme->dropdown.list.border_color);
+    lv_style_set_radius(&(set->styles.dropdown_list), lv_dpx(theme->dropdown.list.corner_radius));
+    lv_style_set_pad_all(&(set->styles.dropdown_list), lv_dpx(theme->dropdown.list.pad));
+
+    reset_style(&(set->styles.dropdown_list_selected), set->are_styles_initialised);
+    lv_style_set_text_color(&(set->styles.dropdown_list_selected), theme->dropdown.list.selection_fg_color);
+    lv_style_set_bg_opa(&(set->styles.dropdown_list_selected), LV_OPA_COVER);
+    lv_style_set_bg_color(&(set->styles.dropdown_list_selected), theme->dropdown.list.selection_bg_color);
+
+    reset_style(&(set->styles.label), set->are_styles_initialised);
+    lv_style_set_text_color(&(set->styles.label), theme->label.fg_color);
+
+    reset_style(&(set->styles.msgbox), set->are_styles_initialised);
+    lv_style_set_text_color(&(set->styles.msgbox), theme->msgbox.fg_color);
+    lv_style_set_bg_opa(&(set->styles.msgbox), LV_OPA_COVER);
+    lv_style_set_bg_color(&(set->styles.msgbox), theme->msgbox.bg_color);
+    lv_style_set_border_side(&(set->styles.msgbox), LV_BORDER_SIDE_FULL);
+    lv_style_set_border_width(&(set->styles.msgbox), lv_dpx(theme->msgbox.border_width));
+    lv_style_set_border_color(&(set->styles.msgbox), theme->msgbox.border_color);
+    lv_style_set_radius(&(set->styles.msgbox), lv_dpx(theme->msgbox.corner_radius));
+    lv_style_set_pad_all(&(set->styles.msgbox), lv_dpx(theme->msgbox.pad));
+
+    reset_style(&(set->styles.msgbox_label), set->are_styles_initialised);
+    lv_style_set_text_align(&(set->styles.msgbox_label), LV_TEXT_ALIGN_CENTER);
+    lv_style_set_pad_bottom(&(set->styles.msgbox_label), lv_dpx(theme->msgbox.gap));
+
+    reset_style(&(set->styles.msgbox_background), set->are_styles_initialised);
+    lv_style_set_bg_color(&(set->styles.msgbox_background), theme->msgbox.dimming.color);
+    lv_style_set_bg_opa(&(set->styles.msgbox_background), theme->msgbox.dimming.opacity);
+
+    reset_style(&(set->styles.bar), set->are_styles_initialised);
+    lv_style_set_border_side(&(set->styles.bar), LV_BORDER_SIDE_FULL);
+    lv_style_set_border_width(&(set->styles.bar), lv_dpx(theme->bar.border_width));
+    lv_style_set_border_color(&(set->styles.bar), theme->bar.border_color);
+    lv_style_set_radius(&(set->styles.bar), lv_dpx(theme->bar.corner_radius));
+
+    reset_style(&(set->styles.bar_indicator), set->are_styles_initialised);
+    lv_style_set_bg_opa(&(set->styles.bar_indicator), LV_OPA_COVER);
+    lv_style_set_bg_color(&(set->styles.bar_indicator), theme->bar.indicator.bg_color);
+
+    set->are_styles_initialised = true;
+
+    const bbx_theme_key *keys[NUM_KEY_CLASSES] = {
+        [KEY_CLASS_CHAR] = &(theme->keyboard.keys.key_char),
+        [KEY_CLASS_NON_CHAR] = &(theme->keyboard.keys.key_non_char),
+        [KEY_CLASS_MOD_ACTIVE] = &(theme->keyboard.keys.key_mod_act),
+        [KEY_CLASS_MOD_INACTIVE] = &(theme->keyboard.keys.key_mod_inact)
+    };
+
+    for (int i = 0; i < NUM_KEY_CLASSES; ++i) {
+        init_key_colors(&(keys[i]->normal), &(set->key_colors[i][0]));
+        init_key_colors(&(keys[i]->pressed), &(set->key_colors[i][1]));
+    }
 }
 
-static void reset_style(lv_style_t *style) {
-    if (are_styles_initialised) {
+static void reset_style(lv_style_t *style, bool is_initialised) {
+    if (is_initialised) {
         lv_style_reset(style);
     } else {
         lv_style_init(style);
     }
 }
 
-static void apply_theme_cb(lv_theme_t *theme, lv_obj_t *obj) {
-    LV_UNUSED(theme);
-
-    lv_obj_add_style(obj, &(styles.widget), 0);
-
-    if (lv_obj_get_parent(obj) == NULL) {
-        lv_obj_add_style(obj, &(styles.window), 0);
-        return;
+static struct style_set *get_style_set(const bbx_theme *theme) {
+    for (int i = 0; i < MAX_STYLE_SETS; ++i) {
+        if (style_sets[i].theme == theme) {
+            return &(style_sets[i]);
+        }
     }
 
-    if (lv_obj_has_flag(obj, BBX_WIDGET_HEADER)) {
-        lv_obj_add_style(obj, &(styles.header), 0);
-        return;
+    /* Reuse an unused set or, failing that, any set other than the current one */
+    struct style_set *set = NULL;
+    for (int i = 0; i < MAX_STYLE_SETS && (!set || set->theme); ++i) {
+        if (&(style_sets[i]) != current_style_set) {
+            set = &(style_sets[i]);
+        }
     }
 
-    if (lv_obj_check_type(obj, &lv_keyboard_class)) {
-        lv_obj_add_style(obj, &(styles.keyboard), 0);
-        lv_obj_add_style(obj, &(styles.key), LV_PART_ITEMS);
-        return;
-    }
+    set->theme = theme;
+    init_styles(theme, set);
 
-    if (lv_obj_check_type(obj, &lv_button_class)) {
-        lv_obj_add_style(obj, &(styles.button), 0);
-        lv_obj_add_style(obj, &(styles.button_pressed), LV_STATE_PRESSED);
-        return;
-    }
+    return set;
+}
 
-    if (lv_obj_check_type(obj, &lv_label_class) && lv_obj_check_type(lv_obj_get_parent(obj), &lv_button_class)) {
-        return; /* Inherit styling from button */
-    }
+static uint32_t get_rule_table_slot(const lv_obj_class_t *class_p, const lv_obj_class_t *parent_class_p) {
+    uintptr_t key = (uintptr_t)class_p ^ ((uintptr_t)parent_class_p * 31);
+    return (uint32_t)((key >> 3) ^ (key >> 11)) & (RULE_TABLE_SIZE - 1);
+}
 
-    if (lv_obj_check_type(obj, &lv_textarea_class)) {
-        lv_obj_add_style(obj, &(styles.textarea), 0);
-        lv_obj_add_style(obj, &(styles.textarea_placeholder), LV_PART_TEXTAREA_PLACEHOLDER);
-        lv_obj_add_style(obj, &(styles.textarea_cursor), LV_PART_CURSOR | LV_STATE_FOCUSED);
-        return;
+static void init_rule_table(void) {
+    for (size_t i = 0; i < sizeof(style_rules) / sizeof(style_rules[0]); ++i) {
+        uint32_t slot = get_rule_table_slot(style_rules[i].class_p, style_rules[i].parent_class_p);
+        while (rule_table[slot]) {
+            slot = (slot + 1) & (RULE_TABLE_SIZE - 1);
+        }
+        rule_table[slot] = &(style_rules[i]);
     }
 
-    if (lv_obj_check_type(obj, &lv_label_class) && lv_obj_check_type(lv_obj_get_parent(obj), &lv_textarea_class)) {
-        return; /* Inherit styling from textarea */
-    }
+    is_rule_table_initialised = true;
+}
 
-    if (lv_obj_check_type(obj, &lv_dropdown_class)) {
-        lv_obj_add_style(obj, &(styles.dropdown), 0);
-        lv_obj_add_style(obj, &(styles.dropdown_pressed), LV_STATE_PRESSED);
-        return;
+static const struct style_rule *find_rule(const lv_obj_class_t *class_p, const lv_obj_class_t *parent_class_p) {
+    uint32_t slot = get_rule_table_slot(class_p, parent_class_p);
+    while (rule_table[slot]) {
+        if (rule_table[slot]->class_p == class_p && rule_table[slot]->parent_class_p == parent_class_p) {
+            return rule_table[slot];
+        }
+        slot = (slot + 1) & (RULE_TABLE_SIZE - 1);
     }
+    return NULL;
+}
 
-    if (lv_obj_check_type(obj, &lv_dropdownlist_class)) {
-        lv_obj_add_style(obj, &(styles.dropdown_list), 0);
-        lv_obj_add_style(obj, &(styles.dropdown_list_selected), LV_PART_SELECTED | LV_STATE_CHECKED);
-        lv_obj_add_style(obj, &(styles.dropdown_list_selected), LV_PART_SELECTED | LV_STATE_PRESSED);
-        return;
-    }
+static void apply_theme_cb(lv_theme_t *theme, lv_obj_t *obj) {
+    LV_UNUSED(theme);
 
-    if (lv_obj_check_type(obj, &lv_label_class) && lv_obj_check_type(lv_obj_get_parent(obj), &lv_dropdownlist_class)) {
-        return; /* Inherit styling from dropdown list */
-    }
+    lv_obj_add_style(obj, &(styles.widget), 0);
 
-    if (lv_obj_check_type(obj, &lv_msgbox_class)) {
-        lv_obj_add_style(obj, &(styles.msgbox), 0);
+    lv_obj_t *parent = lv_obj_get_parent(obj);
+    if (parent == NULL) {
+        lv_obj_add_style(obj, &(styles.window), 0);
         return;
     }
 
-    if (lv_obj_check_type(obj, &lv_label_class) &&
-            (lv_obj_check_type(lv_obj_get_parent(obj), &lv_msgbox_class)
-             || lv_obj_check_type(lv_obj_get_parent(obj), &lv_msgbox_header_class)
-             || lv_obj_check_type(lv_obj_get_parent(obj), &lv_msgbox_content_class)))
-    {
-        lv_obj_add_style(obj, &(styles.msgbox_label), 0);
-        return; /* Inherit styling from message box */
-    }
-
-    if (lv_obj_check_type(obj, &lv_msgbox_footer_button_class)) {
-        lv_obj_add_style(obj, &(styles.button), 0);
-        lv_obj_add_style(obj, &(styles.button_pressed), LV_STATE_PRESSED);
+    if (lv_obj_has_flag(obj, BBX_WIDGET_HEADER)) {
+        lv_obj_add_style(obj, &(styles.header), 0);
         return;
     }
 
-    if (lv_obj_check_type(obj, &lv_msgbox_backdrop_class)) {
-        lv_obj_add_style(obj, &(styles.msgbox_background), 0);
-        return;
+    /* Prefer rules for the specific parent class over rules for any parent */
+    const lv_obj_class_t *class_p = lv_obj_get_class(obj);
+    const struct style_rule *rule = find_rule(class_p, lv_obj_get_class(parent));
+    if (!rule) {
+        rule = find_rule(class_p, NULL);
     }
-
-    if (lv_obj_check_type(obj, &lv_label_class) || lv_obj_check_type(obj, &lv_spangroup_class)) {
-        lv_obj_add_style(obj, &(styles.label), 0);
+    if (!rule) {
         return;
     }
 
-    if (lv_obj_check_type(obj, &lv_bar_class)) {
-        lv_obj_add_style(obj, &(styles.bar), 0);
-        lv_obj_add_style(obj, &(styles.bar_indicator), LV_PART_INDICATOR);
-        return;
+    for (int i = 0; i < MAX_RULE_STYLES && rule->styles[i].style; ++i) {
+        lv_obj_add_style(obj, rule->styles[i].style, rule->styles[i].selector);
     }
 }
 
 static void keyboard_draw_task_added_cb(lv_event_t *event) {
-    lv_obj_t *obj = lv_event_get_target(event);
-    lv_buttonmatrix_t *btnm = (lv_buttonmatrix_t *)obj;
     lv_draw_task_t *draw_task = lv_event_get_draw_task(event);
     lv_draw_dsc_base_t *dsc = draw_task->draw_dsc;
 
@@ -327,33 +498,25 @@ static void keyboard_draw_task_added_cb(lv_event_t *event) {
         return;
     }
 
-    bbx_theme_key *key = NULL;
-
-    if ((btnm->ctrl_bits[dsc->id1] & SQ2LV_CTRL_MOD_INACTIVE) == SQ2LV_CTRL_MOD_INACTIVE) {
-        key = &(current_theme.keyboard.keys.key_mod_inact);
-    } else if ((btnm->ctrl_bits[dsc->id1] & SQ2LV_CTRL_MOD_ACTIVE) == SQ2LV_CTRL_MOD_ACTIVE) {
-        key = &(current_theme.keyboard.keys.key_mod_act);
-    } else if ((btnm->ctrl_bits[dsc->id1] & SQ2LV_CTRL_NON_CHAR) == SQ2LV_CTRL_NON_CHAR) {
-        key = &(current_theme.keyboard.keys.key_non_char);
-    } else {
-        key = &(current_theme.keyboard.keys.key_char);
-    }
-
-    bool pressed = lv_btnmatrix_get_selected_btn(obj) == dsc->id1 && lv_obj_has_state(obj, LV_STATE_PRESSED);
-
-    lv_draw_label_dsc_t *label_dsc = lv_draw_task_get_label_dsc(draw_task);
-    if (label_dsc) {
-        label_dsc->color = lv_color_hex((pressed ? key->pressed : key->normal).fg_color);
-    }
-
-    lv_draw_fill_dsc_t *fill_dsc = lv_draw_task_get_fill_dsc(draw_task);
-    if (fill_dsc) {
-        fill_dsc->color = lv_color_hex((pressed ? key->pressed : key->normal).bg_color);
-    }
+    lv_obj_t *obj = lv_event_get_target(event);
+    lv_buttonmatrix_t *btnm = (lv_buttonmatrix_t *)obj;
 
-    lv_draw_border_dsc_t *border_dsc = lv_draw_task_get_border_dsc(draw_task);
-    if (border_dsc) {
-        border_dsc->color = lv_color_hex((pressed ? key->pressed : key->normal).border_color);
+    int key_class = key_classes[KEY_CTRL_INDEX(btnm->ctrl_bits[dsc->id1])];
+    bool is_pressed = btnm->btn_id_sel == dsc->id1 && lv_obj_has_state(obj, LV_STATE_PRESSED);
+    const struct key_colors *colors = &(current_style_set->key_colors[key_class][is_pressed]);
+
+    switch (draw_task->type) {
+    case LV_DRAW_TASK_TYPE_LABEL:
+        ((lv_draw_label_dsc_t *)draw_task->draw_dsc)->color = colors->fg_color;
+        break;
+    case LV_DRAW_TASK_TYPE_FILL:
+        ((lv_draw_fill_dsc_t *)draw_task->draw_dsc)->color = colors->bg_color;
+        break;
+    case LV_DRAW_TASK_TYPE_BORDER:
+        ((lv_draw_border_dsc_t *)draw_task->draw_dsc)->color = colors->border_color;
+        break;
+    default:
+        break;
     }
 }
 
@@ -367,22 +530,50 @@ void bbx_theme_prepare_keyboard(lv_obj_t *keyboard) {
     lv_obj_add_flag(keyboard, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
 }
 
+void bbx_theme_prepare(const bbx_theme *theme) {
+    if (!theme) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not prepare theme from NULL pointer");
+        return;
+    }
+
+    get_style_set(theme);
+}
+
 void bbx_theme_apply(const bbx_theme *theme) {
     if (!theme) {
         bbx_log(BBX_LOG_LEVEL_ERROR, "Could not apply theme from NULL pointer");
         return;
     }
 
+    if (!is_rule_table_initialised) {
+        init_rule_table();
+    }
+    if (!are_key_classes_initialised) {
+        init_key_classes();
+    }
+
+    struct style_set *set = get_style_set(theme);
+
     lv_theme.disp = NULL;
     lv_theme.font_small = &bbx_font_32;
     lv_theme.font_normal = &bbx_font_32;
     lv_theme.font_large = &bbx_font_32;
     lv_theme.apply_cb = apply_theme_cb;
 
-    current_theme = *theme;
-    init_styles(theme);
+    bool is_first_theme = current_style_set == NULL;
+    current_style_set = set;
 
-    lv_obj_report_style_change(NULL);
-    lv_disp_set_theme(NULL, &lv_theme);
-    lv_theme_apply(lv_scr_act());
+    /* Widgets reference the styles in `styles`. Copying the prebuilt styles into it switches all widgets over without
+     * removing and re-adding their styles. The property arrays remain owned by the style set. */
+    styles = set->styles;
+
+    if (is_first_theme) {
+        lv_disp_set_theme(NULL, &lv_theme);
+        lv_theme_apply(lv_scr_act());
+    } else {
+        /* Every themed widget uses at least one of the swapped styles, and border widths and paddings may differ
+         * between themes. Reporting each style separately would therefore refresh the same widgets once per style
+         * they use, so refresh all widgets once instead. */
+        lv_obj_report_style_change(NULL);
+    }
 }
@@ -20,23 +20,23 @@
 
 /* Window theme */
 typedef struct {
-    uint32_t bg_color;
+    lv_color_t bg_color;
 } bbx_theme_window;
 
 /* Header theme */
 typedef struct {
-    uint32_t bg_color;
+    lv_color_t bg_color;
     lv_coord_t border_width;
-    uint32_t border_color;
+    lv_color_t border_color;
     lv_coord_t pad;
     lv_coord_t gap;
 } bbx_theme_header;
 
 /* Key theme for one specific key type and state */
 typedef struct {
-    uint32_t fg_color;
-    uint32_t bg_color;
-    uint32_t border_color;
+    lv_color_t fg_color;
+    lv_color_t bg_color;
+    lv_color_t border_color;
 } bbx_theme_key_state;
 
 /* Key theme for one specific key type and all states */
@@ -57,9 +57,9 @@ typedef struct {
 
 /* Keyboard theme */
 typedef struct {
-    uint32_t bg_color;
+    lv_color_t bg_color;
     lv_coord_t border_width;
-    uint32_t border_color;
+    lv_color_t border_color;
     lv_coord_t pad;
     lv_coord_t gap;
     bbx_theme_keys keys;
@@ -67,9 +67,9 @@ typedef struct {
 
 /* Button theme for one specific button state */
 typedef struct {
-    uint32_t fg_color;
-    uint32_t bg_color;
-    uint32_t border_color;
+    lv_color_t fg_color;
+    lv_color_t bg_color;
+    lv_color_t border_color;
 } bbx_theme_button_state;
 
 /* Button theme */
@@ -84,30 +84,30 @@ typedef struct {
 /* Text area cursor theme */
 typedef struct {
     lv_coord_t width;
-    uint32_t color;
+    lv_color_t color;
     int period;
 } bbx_theme_textarea_cursor;
 
 /* Text area theme */
 typedef struct {
-    uint32_t fg_color;
-    uint32_t bg_color;
+    lv_color_t fg_color;
+    lv_color_t bg_color;
     lv_coord_t border_width;
-    uint32_t border_color;
+    lv_color_t border_color;
     lv_coord_t corner_radius;
     lv_coord_t pad;
-    uint32_t placeholder_color;
+    lv_color_t placeholder_color;
     bbx_theme_textarea_cursor cursor;
 } bbx_theme_textarea;
 
 /* Dropdown list theme */
 typedef struct {
-    uint32_t fg_color;
-    uint32_t bg_color;
-    uint32_t selection_fg_color;
-    uint32_t selection_bg_color;
+    lv_color_t fg_color;
+    lv_color_t bg_color;
+    lv_color_t selection_fg_color;
+    lv_color_t selection_bg_color;
     lv_coord_t border_width;
-    uint32_t border_color;
+    lv_color_t border_color;
     lv_coord_t corner_radius;
     lv_coord_t pad;
 } bbx_theme_dropdown_list;
@@ -120,21 +120,21 @@ typedef struct {
 
 /* Label */
 typedef struct {
-    uint32_t fg_color;
+    lv_color_t fg_color;
 } bbx_theme_label;
 
 /* Message box dimming theme */
 typedef struct {
-    uint32_t color;
+    lv_color_t color;
     short opacity;
 } bbx_theme_msgbox_dimming;
 
 /* Message box theme */
 typedef struct {
-    uint32_t fg_color;
-    uint32_t bg_color;
+    lv_color_t fg_color;
+    lv_color_t bg_color;
     lv_coord_t border_width;
-    uint32_t border_color;
+    lv_color_t border_color;
     lv_coord_t corner_radius;
     lv_coord_t pad;
     lv_coord_t gap;
@@ -143,13 +143,13 @@ typedef struct {
 
 /* Progress bar indicator theme */
 typedef struct {
-    uint32_t bg_color;
+    lv_color_t bg_color;
 } bbx_theme_bar_indicator;
 
 /* Progress bar theme */
 typedef struct {
     lv_coord_t border_width;
-    uint32_t border_color;
+    lv_color_t border_color;
     lv_coord_t corner_radius;
     bbx_theme_bar_indicator indicator;
 } bbx_theme_bar;
@@ -175,6 +175,14 @@ typedef struct {
  */
 void bbx_theme_prepare_keyboard(lv_obj_t *keyboard);
 
+/**
+ * Build the styles for a theme ahead of time so that a later bbx_theme_apply with the same theme only needs to
+ * refresh the widgets.
+ *
+ * @param theme the theme to prepare
+ */
+void bbx_theme_prepare(const bbx_theme *theme);
+
 /**
  * Apply a UI theme.
  *
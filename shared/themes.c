@@ -7,646 +7,319 @@
 #include "themes.h"
 
 #include "log.h"
+#include "themes/builtin.h"
 
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/**
+ * Defines
+ */
+
+#define FILE_MAGIC "BBXT"
+#define FILE_VERSION 1
+
+#define MAX_LOADED_THEMES 8
+
+#define THEME_FIELD(member) { offsetof(bbx_theme, member), sizeof(((bbx_theme *)NULL)->member), false }
+#define THEME_COLOR(member) { offsetof(bbx_theme, member), sizeof(lv_color_t), true }
 
 
 /**
  * Static variables
  */
 
-/* Breezy light (based on KDE Breeze color palette, see https://develop.kde.org/hig/style/color/default/) */
-static const bbx_theme breezy_light = {
-    .name = "breezy-light",
-    .window = {
-        .bg_color = 0xeff0f1
-    },
-    .header = {
-        .bg_color = 0xfcfcfc,
-        .border_width = 1,
-        .border_color = 0xbdc3c7,
-        .pad = 10,
-        .gap = 10
-    },
-    .keyboard = {
-        .bg_color = 0xfcfcfc,
-        .border_width = 1,
-        .border_color = 0xbdc3c7,
-        .pad = 10,
-        .gap = 10,
-        .keys = {
-            .border_width = 1,
-            .corner_radius = 5,
-            .key_char = {
-                .normal = {
-                    .fg_color = 0x232629,
-                    .bg_color = 0xeff0f1,
-                    .border_color = 0xbdc3c7
-                },
-                .pressed = {
-                    .fg_color = 0x232629,
-                    .bg_color = 0x3daee9,
-                    .border_color = 0x2980b9
-                }
-            },
-            .key_non_char = {
-                .normal = {
-                    .fg_color = 0x232629,
-                    .bg_color = 0xbdc3c7,
-                    .border_color = 0x7f8c8d
-                },
-                .pressed = {
-                    .fg_color = 0x232629,
-                    .bg_color = 0x3daee9,
-                    .border_color = 0x2980b9
-                }
-            },
-            .key_mod_act = {
-                .normal = {
-                    .fg_color = 0x232629,
-                    .bg_color = 0x3daee9,
-                    .border_color = 0x2980b9
-                },
-                .pressed = {
-                    .fg_color = 0x232629,
-                    .bg_color = 0x3daee9,
-                    .border_color = 0x2980b9
-                }
-            },
-            .key_mod_inact = {
-                .normal = {
-                    .fg_color = 0x232629,
-                    .bg_color = 0xbdc3c7,
-                    .border_color = 0x7f8c8d
-                },
-                .pressed = {
-                    .fg_color = 0x232629,
-                    .bg_color = 0x3daee9,
-                    .border_color = 0x2980b9
-                }
-            }
-        }
-    },
-    .button = {
-        .border_width = 1,
-        .corner_radius = 5,
-        .pad = 5,
-        .normal = {
-            .fg_color = 0x232629,
-            .bg_color = 0xeff0f1,
-            .border_color = 0xbdc3c7
-        },
-        .pressed = {
-            .fg_color = 0x232629,
-            .bg_color = 0x3daee9,
-            .border_color = 0x2980b9
-        }
-    },
-    .textarea = {
-        .fg_color = 0x232629,
-        .bg_color = 0xfcfcfc,
-        .border_width = 1,
-        .border_color = 0xbdc3c7,
-        .corner_radius = 5,
-        .pad = 5,
-        .placeholder_color = 0x7f8c8d,
-        .cursor = {
-            .width = 1,
-            .color = 0x232629,
-            .period = 700
-        }
-    },
-    .dropdown = {
-        .button = {
-            .border_width = 1,
-            .corner_radius = 5,
-            .pad = 5,
-            .normal = {
-                .fg_color = 0x232629,
-                .bg_color = 0xeff0f1,
-                .border_color = 0xbdc3c7
-            },
-            .pressed = {
-                .fg_color = 0x232629,
-                .bg_color = 0x3daee9,
-                .border_color = 0x2980b9
-            }
-        },
-        .list = {
-            .fg_color = 0x232629,
-            .bg_color = 0xfcfcfc,
-            .selection_fg_color = 0x232629,
-            .selection_bg_color = 0x3daee9,
-            .border_width = 1,
-            .border_color = 0xbdc3c7,
-            .corner_radius = 0,
-            .pad = 0
-        }
-    },
-    .label = {
-        .fg_color = 0x232629
-    },
-    .msgbox = {
-        .fg_color = 0x232629,
-        .bg_color = 0xeff0f1,
-        .border_width = 1,
-        .border_color = 0xbdc3c7,
-        .corner_radius = 0,
-        .pad = 20,
-        .gap = 20,
-        .dimming = {
-            .color = 0x232629,
-            .opacity = 178
-        }
-    },
-    .bar = {
-        .border_width = 1,
-        .border_color = 0x3daee9,
-        .corner_radius = 5,
-        .indicator = {
-            .bg_color = 0x3daee9
-        }
-    }
+/* Header of a binary theme file. All values are little-endian and offsets are relative to the start
+ * of the file. Keep in sync with the writer in themes/compile-theme.py. */
+struct file_header {
+    char magic[4];
+    uint32_t version;
+    uint32_t size;
+    uint32_t name;
+    uint32_t num_fields;
+    /* Followed by num_fields 32-bit values in the order of theme_fields */
 };
 
+/* Location of a field in bbx_theme */
+struct theme_field {
+    size_t offset;
+    size_t size;
+    bool is_color; /* Stored as 0xRRGGBB in files */
+};
 
-/* Breezy dark (based on KDE Breeze Dark color palette, see https://develop.kde.org/hig/style/color/dark/) */
-static const bbx_theme breezy_dark = {
-    .name = "breezy-dark",
-    .window = {
-        .bg_color = 0x31363b
-    },
-    .header = {
-        .bg_color = 0x232629,
-        .border_width = 1,
-        .border_color = 0x7f8c8d,
-        .pad = 10,
-        .gap = 10
-    },
-    .keyboard = {
-        .bg_color = 0x232629,
-        .border_width = 1,
-        .border_color = 0x7f8c8d,
-        .pad = 10,
-        .gap = 10,
-        .keys = {
-            .border_width = 1,
-            .corner_radius = 5,
-            .key_char = {
-                .normal = {
-                    .fg_color = 0xeff0f1,
-                    .bg_color = 0x31363b,
-                    .border_color = 0xbdc3c7
-                },
-                .pressed = {
-                    .fg_color = 0xeff0f1,
-                    .bg_color = 0x3daee9,
-                    .border_color = 0x2980b9
-                }
-            },
-            .key_non_char = {
-                .normal = {
-                    .fg_color = 0xeff0f1,
-                    .bg_color = 0x232629,
-                    .border_color = 0x7f8c8d
-                },
-                .pressed = {
-                    .fg_color = 0xeff0f1,
-                    .bg_color = 0x3daee9,
-                    .border_color = 0x2980b9
-                }
-            },
-            .key_mod_act = {
-                .normal = {
-                    .fg_color = 0xeff0f1,
-                    .bg_color = 0x3daee9,
-                    .border_color = 0x2980b9
-                },
-                .pressed = {
-                    .fg_color = 0xeff0f1,
-                    .bg_color = 0x3daee9,
-                    .border_color = 0x2980b9
-                }
-            },
-            .key_mod_inact = {
-                .normal = {
-                    .fg_color = 0xeff0f1,
-                    .bg_color = 0x232629,
-                    .border_color = 0x7f8c8d
-                },
-                .pressed = {
-                    .fg_color = 0xeff0f1,
-                    .bg_color = 0x3daee9,
-                    .border_color = 0x2980b9
-                }
-            }
-        }
-    },
-    .button = {
-        .border_width = 1,
-        .corner_radius = 5,
-        .pad = 5,
-        .normal = {
-            .fg_color = 0xeff0f1,
-            .bg_color = 0x31363b,
-            .border_color = 0xbdc3c7
-        },
-        .pressed = {
-            .fg_color = 0xeff0f1,
-            .bg_color = 0x3daee9,
-            .border_color = 0x2980b9
-        }
-    },
-    .textarea = {
-        .fg_color = 0xeff0f1,
-        .bg_color = 0x232629,
-        .border_width = 1,
-        .border_color = 0x7f8c8d,
-        .corner_radius = 5,
-        .pad = 5,
-        .placeholder_color = 0x7f8c8d,
-        .cursor = {
-            .width = 1,
-            .color = 0xeff0f1,
-            .period = 700
-        }
-    },
-    .dropdown = {
-        .button = {
-            .border_width = 1,
-            .corner_radius = 5,
-            .pad = 5,
-            .normal = {
-                .fg_color = 0xeff0f1,
-                .bg_color = 0x31363b,
-                .border_color = 0xbdc3c7
-            },
-            .pressed = {
-                .fg_color = 0xeff0f1,
-                .bg_color = 0x3daee9,
-                .border_color = 0x2980b9
-            }
-        },
-        .list = {
-            .fg_color = 0xeff0f1,
-            .bg_color = 0x232629,
-            .selection_fg_color = 0x232629,
-            .selection_bg_color = 0x3daee9,
-            .border_width = 1,
-            .border_color = 0x7f8c8d,
-            .corner_radius = 0,
-            .pad = 0
-        }
-    },
-    .label = {
-        .fg_color = 0xeff0f1
-    },
-    .msgbox = {
-        .fg_color = 0xeff0f1,
-        .bg_color = 0x31363b,
-        .border_width = 1,
-        .border_color = 0x3b4045,
-        .corner_radius = 0,
-        .pad = 20,
-        .gap = 20,
-        .dimming = {
-            .color = 0x232629,
-            .opacity = 178
-        }
-    },
-    .bar = {
-        .border_width = 1,
-        .border_color = 0x3daee9,
-        .corner_radius = 5,
-        .indicator = {
-            .bg_color = 0x3daee9
-        }
-    }
+/* Fields stored in binary theme files, in file order */
+static const struct theme_field theme_fields[] = {
+    THEME_COLOR(window.bg_color),
+    THEME_COLOR(header.bg_color),
+    THEME_FIELD(header.border_width),
+    THEME_COLOR(header.border_color),
+    THEME_FIELD(header.pad),
+    THEME_FIELD(header.gap),
+    THEME_COLOR(keyboard.bg_color),
+    THEME_FIELD(keyboard.border_width),
+    THEME_COLOR(keyboard.border_color),
+    THEME_FIELD(keyboard.pad),
+    THEME_FIELD(keyboard.gap),
+    THEME_FIELD(keyboard.keys.border_width),
+    THEME_FIELD(keyboard.keys.corner_radius),
+    THEME_COLOR(keyboard.keys.key_char.normal.fg_color),
+    THEME_COLOR(keyboard.keys.key_char.normal.bg_color),
+    THEME_COLOR(keyboard.keys.key_char.normal.border_color),
+    THEME_COLOR(keyboard.keys.key_char.pressed.fg_color),
+    THEME_COLOR(keyboard.keys.key_char.pressed.bg_color),
+    THEME_COLOR(keyboard.keys.key_char.pressed.border_color),
+    THEME_COLOR(keyboard.keys.key_non_char.normal.fg_color),
+    THEME_COLOR(keyboard.keys.key_non_char.normal.bg_color),
+    THEME_COLOR(keyboard.keys.key_non_char.normal.border_color),
+    THEME_COLOR(keyboard.keys.key_non_char.pressed.fg_color),
+    THEME_COLOR(keyboard.keys.key_non_char.pressed.bg_color),
+    THEME_COLOR(keyboard.keys.key_non_char.pressed.border_color),
+    THEME_COLOR(keyboard.keys.key_mod_act.normal.fg_color),
+    THEME_COLOR(keyboard.keys.key_mod_act.normal.bg_color),
+    THEME_COLOR(keyboard.keys.key_mod_act.normal.border_color),
+    THEME_COLOR(keyboard.keys.key_mod_act.pressed.fg_color),
+    THEME_COLOR(keyboard.keys.key_mod_act.pressed.bg_color),
+    THEME_COLOR(keyboard.keys.key_mod_act.pressed.border_color),
+    THEME_COLOR(keyboard.keys.key_mod_inact.normal.fg_color),
+    THEME_COLOR(keyboard.keys.key_mod_inact.normal.bg_color),
+    THEME_COLOR(keyboard.keys.key_mod_inact.normal.border_color),
+    THEME_COLOR(keyboard.keys.key_mod_inact.pressed.fg_color),
+    THEME_COLOR(keyboard.keys.key_mod_inact.pressed.bg_color),
+    THEME_COLOR(keyboard.keys.key_mod_inact.pressed.border_color),
+    THEME_FIELD(button.border_width),
+    THEME_FIELD(button.corner_radius),
+    THEME_FIELD(button.pad),
+    THEME_COLOR(button.normal.fg_color),
+    THEME_COLOR(button.normal.bg_color),
+    THEME_COLOR(button.normal.border_color),
+    THEME_COLOR(button.pressed.fg_color),
+    THEME_COLOR(button.pressed.bg_color),
+    THEME_COLOR(button.pressed.border_color),
+    THEME_COLOR(textarea.fg_color),
+    THEME_COLOR(textarea.bg_color),
+    THEME_FIELD(textarea.border_width),
+    THEME_COLOR(textarea.border_color),
+    THEME_FIELD(textarea.corner_radius),
+    THEME_FIELD(textarea.pad),
+    THEME_COLOR(textarea.placeholder_color),
+    THEME_FIELD(textarea.cursor.width),
+    THEME_COLOR(textarea.cursor.color),
+    THEME_FIELD(textarea.cursor.period),
+    THEME_FIELD(dropdown.button.border_width),
+    THEME_FIELD(dropdown.button.corner_radius),
+    THEME_FIELD(dropdown.button.pad),
+    THEME_COLOR(dropdown.button.normal.fg_color),
+    THEME_COLOR(dropdown.button.normal.bg_color),
+    THEME_COLOR(dropdown.button.normal.border_color),
+    THEME_COLOR(dropdown.button.pressed.fg_color),
+    THEME_COLOR(dropdown.button.pressed.bg_color),
+    THEME_COLOR(dropdown.button.pressed.border_color),
+    THEME_COLOR(dropdown.list.fg_color),
+    THEME_COLOR(dropdown.list.bg_color),
+    THEME_COLOR(dropdown.list.selection_fg_color),
+    THEME_COLOR(dropdown.list.selection_bg_color),
+    THEME_FIELD(dropdown.list.border_width),
+    THEME_COLOR(dropdown.list.border_color),
+    THEME_FIELD(dropdown.list.corner_radius),
+    THEME_FIELD(dropdown.list.pad),
+    THEME_COLOR(label.fg_color),
+    THEME_COLOR(msgbox.fg_color),
+    THEME_COLOR(msgbox.bg_color),
+    THEME_FIELD(msgbox.border_width),
+    THEME_COLOR(msgbox.border_color),
+    THEME_FIELD(msgbox.corner_radius),
+    THEME_FIELD(msgbox.pad),
+    THEME_FIELD(msgbox.gap),
+    THEME_COLOR(msgbox.dimming.color),
+    THEME_FIELD(msgbox.dimming.opacity),
+    THEME_FIELD(bar.border_width),
+    THEME_COLOR(bar.border_color),
+    THEME_FIELD(bar.corner_radius),
+    THEME_COLOR(bar.indicator.bg_color)
 };
 
-/* pmOS light (based on palette https://coolors.co/009900-395e66-db504a-e3b505-ebf5ee) */
-static const bbx_theme pmos_light = {
-    .name = "pmos-light",
-    .window = {
-        .bg_color = 0xf2f7f8,
-    },
-    .header = {
-        .bg_color = 0xf2f7f8,
-        .border_width = 0,
-        .border_color = 0xf2f7f8,
-        .pad = 20,
-        .gap = 10
-    },
-    .keyboard = {
-        .bg_color = 0xd8e6e9,
-        .border_width = 2,
-        .border_color = 0x97bcc4,
-        .pad = 20,
-        .gap = 10,
-        .keys = {
-            .border_width = 1,
-            .corner_radius = 3,
-            .key_char = {
-                .normal = {
-                    .fg_color = 0x070c0d,
-                    .bg_color = 0xd8e6e9,
-                    .border_color = 0x97bcc4
-                },
-                .pressed = {
-                    .fg_color = 0xf2f7f8,
-                    .bg_color = 0x009900,
-                    .border_color = 0x009900
-                }
-            },
-            .key_non_char = {
-                .normal = {
-                    .fg_color = 0x070c0d,
-                    .bg_color = 0xbed5da,
-                    .border_color = 0xb1cdd3
-                },
-                .pressed = {
-                    .fg_color = 0xf2f7f8,
-                    .bg_color = 0x009900,
-                    .border_color = 0x009900
-                }
-            },
-            .key_mod_act = {
-                .normal = {
-                    .fg_color = 0x009900,
-                    .bg_color = 0xbed5da,
-                    .border_color = 0x009900
-                },
-                .pressed = {
-                    .fg_color = 0xf2f7f8,
-                    .bg_color = 0x009900,
-                    .border_color = 0x009900
-                }
-            },
-            .key_mod_inact = {
-                .normal = {
-                    .fg_color = 0x070c0d,
-                    .bg_color = 0xbed5da,
-                    .border_color = 0xb1cdd3
-                },
-                .pressed = {
-                    .fg_color = 0xf2f7f8,
-                    .bg_color = 0x009900,
-                    .border_color = 0x009900
-                }
-            }
-        }
-    },
-    .button = {
-        .border_width = 1,
-        .corner_radius = 3,
-        .pad = 8,
-        .normal = {
-            .fg_color = 0x070c0d,
-            .bg_color = 0xbed5da,
-            .border_color = 0xb1cdd3
-        },
-        .pressed = {
-            .fg_color = 0xf2f7f8,
-            .bg_color = 0x009900,
-            .border_color = 0x009900
-        }
-    },
-    .textarea = {
-        .fg_color = 0x070c0d,
-        .bg_color = 0xebffeb,
-        .border_width = 1,
-        .border_color = 0x009900,
-        .corner_radius = 3,
-        .pad = 8,
-        .placeholder_color = 0x009900,
-        .cursor = {
-            .width = 2,
-            .color = 0x009900,
-            .period = 700
-        }
-    },
-    .dropdown = {
-        .button = {
-            .border_width = 1,
-            .corner_radius = 3,
-            .pad = 8,
-            .normal = {
-                .fg_color = 0x070c0d,
-                .bg_color = 0xbed5da,
-                .border_color = 0xb1cdd3
-            },
-            .pressed = {
-                .fg_color = 0xf2f7f8,
-                .bg_color = 0x009900,
-                .border_color = 0x009900
-            }
-        },
-        .list = {
-            .fg_color = 0x070c0d,
-            .bg_color = 0xd8e6e9,
-            .selection_fg_color = 0xf2f7f8,
-            .selection_bg_color = 0x009900,
-            .border_width = 1,
-            .border_color = 0x97bcc4,
-            .corner_radius = 0,
-            .pad = 8
-        }
-    },
-    .label = {
-        .fg_color = 0x070c0d
-    },
-    .msgbox = {
-        .fg_color = 0x070c0d,
-        .bg_color = 0xd8e6e9,
-        .border_width = 1,
-        .border_color = 0x97bcc4,
-        .corner_radius = 3,
-        .pad = 20,
-        .gap = 20,
-        .dimming = {
-            .color = 0x070c0d,
-            .opacity = 225
-        }
-    },
-    .bar = {
-        .border_width = 1,
-        .border_color = 0x009900,
-        .corner_radius = 3,
-        .indicator = {
-            .bg_color = 0x009900
-        }
-    }
+static const int num_theme_fields = sizeof(theme_fields) / sizeof(theme_fields[0]);
+
+/* Theme loaded from a binary theme file */
+struct loaded_theme {
+    char *path;
+    bbx_theme theme;
 };
 
-/* pmOS dark (based on palette https://coolors.co/009900-395e66-db504a-e3b505-ebf5ee) */
-static const bbx_theme pmos_dark = {
-    .name = "pmos-dark",
-    .window = {
-        .bg_color = 0x070c0d
-    },
-    .header = {
-        .bg_color = 0x070c0d,
-        .border_width = 0,
-        .border_color = 0x070c0d,
-        .pad = 20,
-        .gap = 10
-    },
-    .keyboard = {
-        .bg_color = 0x162427,
-        .border_width = 2,
-        .border_color = 0x395e66,
-        .pad = 20,
-        .gap = 10,
-        .keys = {
-            .border_width = 1,
-            .corner_radius = 3,
-            .key_char = {
-                .normal = {
-                    .fg_color = 0xf2f7f8,
-                    .bg_color = 0x162427,
-                    .border_color = 0x395e66
-                },
-                .pressed = {
-                    .fg_color = 0xf2f7f8,
-                    .bg_color = 0x009900,
-                    .border_color = 0x009900
-                }
-            },
-            .key_non_char = {
-                .normal = {
-                    .fg_color = 0xf2f7f8,
-                    .bg_color = 0x253c41,
-                    .border_color = 0x2c484e
-                },
-                .pressed = {
-                    .fg_color = 0xf2f7f8,
-                    .bg_color = 0x009900,
-                    .border_color = 0x009900
-                }
-            },
-            .key_mod_act = {
-                .normal = {
-                    .fg_color = 0x009900,
-                    .bg_color = 0x253c41,
-                    .border_color = 0x009900
-                },
-                .pressed = {
-                    .fg_color = 0xf2f7f8,
-                    .bg_color = 0x009900,
-                    .border_color = 0x009900
-                }
-            },
-            .key_mod_inact = {
-                .normal = {
-                    .fg_color = 0xf2f7f8,
-                    .bg_color = 0x253c41,
-                    .border_color = 0x2c484e
-                },
-                .pressed = {
-                    .fg_color = 0xf2f7f8,
-                    .bg_color = 0x009900,
-                    .border_color = 0x009900
-                }
-            }
-        }
-    },
-    .button = {
-        .border_width = 1,
-        .corner_radius = 3,
-        .pad = 8,
-        .normal = {
-            .fg_color = 0xf2f7f8,
-            .bg_color = 0x253c41,
-            .border_color = 0x2c484e
-        },
-        .pressed = {
-            .fg_color = 0xf2f7f8,
-            .bg_color = 0x009900,
-            .border_color = 0x009900
-        }
-    },
-    .textarea = {
-        .fg_color = 0xf2f7f8,
-        .bg_color = 0x002900,
-        .border_width = 1,
-        .border_color = 0x009900,
-        .corner_radius = 3,
-        .pad = 8,
-        .placeholder_color = 0x009900,
-        .cursor = {
-            .width = 2,
-            .color = 0x009900,
-            .period = 700
-        }
-    },
-    .dropdown = {
-        .button = {
-            .border_width = 1,
-            .corner_radius = 3,
-            .pad = 8,
-            .normal = {
-                .fg_color = 0xf2f7f8,
-                .bg_color = 0x253c41,
-                .border_color = 0x2c484e
-            },
-            .pressed = {
-                .fg_color = 0xf2f7f8,
-                .bg_color = 0x009900,
-                .border_color = 0x009900
-            }
-        },
-        .list = {
-            .fg_color = 0xf2f7f8,
-            .bg_color = 0x162427,
-            .selection_fg_color = 0xf2f7f8,
-            .selection_bg_color = 0x009900,
-            .border_width = 1,
-            .border_color = 0x395e66,
-            .corner_radius = 0,
-            .pad = 8
-        }
-    },
-    .label = {
-        .fg_color = 0xf2f7f8,
-    },
-    .msgbox = {
-        .fg_color = 0xf2f7f8,
-        .bg_color = 0x162427,
-        .border_width = 1,
-        .border_color = 0x395e66,
-        .corner_radius = 3,
-        .pad = 20,
-        .gap = 20,
-        .dimming = {
-            .color = 0x070c0d,
-            .opacity = 225
-        }
-    },
-    .bar = {
-        .border_width = 1,
-        .border_color = 0x009900,
-        .corner_radius = 3,
-        .indicator = {
-            .bg_color = 0x009900
+static struct loaded_theme loaded_themes[MAX_LOADED_THEMES];
+static int num_loaded_themes = 0;
+
+
+/**
+ * Static prototypes
+ */
+
+/**
+ * Compute the FNV-1a hash of a theme name. Keep in sync with name_hash in themes/compile-theme.py.
+ *
+ * @param name theme name
+ * @param seed initial hash value
+ * @return the hash
+ */
+static uint32_t hash_name(const char *name, uint32_t seed);
+
+/**
+ * Populate a theme from the contents of a binary theme file.
+ *
+ * @param data file contents
+ * @param size size of data in bytes
+ * @param theme theme to populate
+ * @return true on success, false if the data is invalid
+ */
+static bool load_theme_from_data(const uint8_t *data, size_t size, bbx_theme *theme);
+
+
+/**
+ * Static functions
+ */
+
+static uint32_t hash_name(const char *name, uint32_t seed) {
+    uint32_t hash = seed;
+    for (const unsigned char *c = (const unsigned char *)name; *c; ++c) {
+        hash = (hash ^ *c) * 16777619u;
+    }
+    return hash;
+}
+
+static bool load_theme_from_data(const uint8_t *data, size_t size, bbx_theme *theme) {
+    struct file_header header;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+
+    if (memcmp(header.magic, FILE_MAGIC, sizeof(header.magic)) != 0 || header.version != FILE_VERSION
+            || header.size != size) {
+        return false;
+    }
+
+    /* Themes need to define every field */
+    if (header.num_fields != (uint32_t)num_theme_fields
+            || sizeof(header) + num_theme_fields * sizeof(uint32_t) > size) {
+        return false;
+    }
+
+    if (header.name >= size || !memchr(data + header.name, '\0', size - header.name)) {
+        return false;
+    }
+
+    theme->name = strdup((const char *)(data + header.name));
+    if (!theme->name) {
+        return false;
+    }
+
+    const uint8_t *values = data + sizeof(header);
+    for (int i = 0; i < num_theme_fields; ++i) {
+        uint32_t value;
+        memcpy(&value, values + i * sizeof(value), sizeof(value));
+
+        uint8_t *field = (uint8_t *)theme + theme_fields[i].offset;
+        if (theme_fields[i].is_color) {
+            lv_color_t color = lv_color_hex(value);
+            memcpy(field, &color, sizeof(color));
+        } else if (theme_fields[i].size == sizeof(int16_t)) {
+            int16_t short_value = (int16_t)value;
+            memcpy(field, &short_value, sizeof(short_value));
+        } else {
+            memcpy(field, &value, sizeof(value));
         }
     }
-};
+
+    return true;
+}
+
 
 /**
  * Public interface
  */
 
-const int bbx_themes_num_themes = 4;
-const bbx_theme *bbx_themes_themes[] = {
-    &breezy_light,
-    &breezy_dark,
-    &pmos_light,
-    &pmos_dark
-};
+bbx_themes_theme_id_t bbx_themes_load_theme(const char *path) {
+    for (int i = 0; i < num_loaded_themes; ++i) {
+        if (strcmp(loaded_themes[i].path, path) == 0) {
+            return bbx_themes_num_themes + i;
+        }
+    }
+
+    if (num_loaded_themes >= MAX_LOADED_THEMES) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Cannot load theme file %s because the maximum of %d theme files was reached",
+            path, MAX_LOADED_THEMES);
+        return BBX_THEMES_THEME_NONE;
+    }
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Could not open theme file %s", path);
+        return BBX_THEMES_THEME_NONE;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(struct file_header)) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Could not load theme file %s because it is too small", path);
+        close(fd);
+        return BBX_THEMES_THEME_NONE;
+    }
+
+    size_t size = st.st_size;
+    const uint8_t *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Could not map theme file %s", path);
+        return BBX_THEMES_THEME_NONE;
+    }
+
+    struct loaded_theme *loaded_theme = &(loaded_themes[num_loaded_themes]);
+    loaded_theme->path = strdup(path);
+    bool is_valid = loaded_theme->path && load_theme_from_data(data, size, &(loaded_theme->theme));
+    munmap((void *)data, size);
+
+    if (!is_valid) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Could not load invalid theme file %s", path);
+        free(loaded_theme->path);
+        loaded_theme->path = NULL;
+        return BBX_THEMES_THEME_NONE;
+    }
+
+    return bbx_themes_num_themes + num_loaded_themes++;
+}
+
+int bbx_themes_get_num_themes(void) {
+    return bbx_themes_num_themes + num_loaded_themes;
+}
+
+const bbx_theme *bbx_themes_get_theme(bbx_themes_theme_id_t id) {
+    if (id >= 0 && id < bbx_themes_num_themes) {
+        return bbx_themes_themes[id];
+    }
+    if (id >= bbx_themes_num_themes && id < bbx_themes_get_num_themes()) {
+        return &(loaded_themes[id - bbx_themes_num_themes].theme);
+    }
+    return NULL;
+}
 
 bbx_themes_theme_id_t bbx_themes_find_theme_with_name(const char *name) {
-    for (int i = 0; i < bbx_themes_num_themes; ++i) {
-        if (strcmp(bbx_themes_themes[i]->name, name) == 0) {
+    uint32_t slot = hash_name(name, bbx_themes_name_hash_seed) % bbx_themes_name_hash_size;
+    bbx_themes_theme_id_t id = bbx_themes_name_hash_slots[slot];
+    if (id != BBX_THEMES_THEME_NONE && strcmp(bbx_themes_themes[id]->name, name) == 0) {
+        bbx_log(BBX_LOG_LEVEL_VERBOSE, "Found theme: %s\n", name);
+        return id;
+    }
+
+    /* Themes loaded from files aren't hashed */
+    for (int i = bbx_themes_num_themes; i < bbx_themes_get_num_themes(); ++i) {
+        if (strcmp(bbx_themes_get_theme(i)->name, name) == 0) {
             bbx_log(BBX_LOG_LEVEL_VERBOSE, "Found theme: %s\n", name);
             return i;
         }
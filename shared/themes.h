@@ -9,7 +9,8 @@
 
 #include "theme.h"
 
-/* Theme IDs, values can be used as indexes into the bbx_themes_themes array */
+/* Theme IDs, built-in theme values can be used as indexes into the bbx_themes_themes array. Themes loaded
+ * from files are assigned IDs from bbx_themes_num_themes onwards. */
 typedef enum {
     BBX_THEMES_THEME_NONE = -1,
     BBX_THEMES_THEME_BREEZY_LIGHT = 0,
@@ -18,10 +19,34 @@ typedef enum {
     BBX_THEMES_THEME_PMOS_DARK = 3
 } bbx_themes_theme_id_t;
 
-/* Themes */
+/* Built-in themes, generated from the INI files in themes/ */
 extern const int bbx_themes_num_themes;
 extern const bbx_theme *bbx_themes_themes[];
 
+/**
+ * Load a theme from a binary theme file as generated by themes/compile-theme.py. Loading the same path
+ * more than once returns the previously loaded theme.
+ *
+ * @param path path to the theme file
+ * @return ID of the loaded theme or BBX_THEMES_THEME_NONE if the file could not be loaded
+ */
+bbx_themes_theme_id_t bbx_themes_load_theme(const char *path);
+
+/**
+ * Get the total number of built-in and loaded themes.
+ *
+ * @return number of themes
+ */
+int bbx_themes_get_num_themes(void);
+
+/**
+ * Get a built-in or loaded theme.
+ *
+ * @param id theme ID
+ * @return the theme or NULL if the ID is invalid
+ */
+const bbx_theme *bbx_themes_get_theme(bbx_themes_theme_id_t id);
+
 /**
  * Find the first theme with a given name.
  *
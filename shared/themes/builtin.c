@@ -0,0 +1,651 @@
+/**
+ * Auto-generated with compile-theme.py
+ **/
+
+#include "builtin.h"
+
+
+/* Breezy light (based on KDE Breeze color palette, see https://develop.kde.org/hig/style/color/default/) */
+static const bbx_theme breezy_light = {
+    .name = "breezy-light",
+    .window = {
+        .bg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1)
+    },
+    .header = {
+        .bg_color = LV_COLOR_MAKE(0xfc, 0xfc, 0xfc),
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0xbd, 0xc3, 0xc7),
+        .pad = 10,
+        .gap = 10
+    },
+    .keyboard = {
+        .bg_color = LV_COLOR_MAKE(0xfc, 0xfc, 0xfc),
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0xbd, 0xc3, 0xc7),
+        .pad = 10,
+        .gap = 10,
+        .keys = {
+            .border_width = 1,
+            .corner_radius = 5,
+            .key_char = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+                    .bg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+                    .border_color = LV_COLOR_MAKE(0xbd, 0xc3, 0xc7)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+                    .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+                    .border_color = LV_COLOR_MAKE(0x29, 0x80, 0xb9)
+                }
+            },
+            .key_non_char = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+                    .bg_color = LV_COLOR_MAKE(0xbd, 0xc3, 0xc7),
+                    .border_color = LV_COLOR_MAKE(0x7f, 0x8c, 0x8d)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+                    .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+                    .border_color = LV_COLOR_MAKE(0x29, 0x80, 0xb9)
+                }
+            },
+            .key_mod_act = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+                    .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+                    .border_color = LV_COLOR_MAKE(0x29, 0x80, 0xb9)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+                    .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+                    .border_color = LV_COLOR_MAKE(0x29, 0x80, 0xb9)
+                }
+            },
+            .key_mod_inact = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+                    .bg_color = LV_COLOR_MAKE(0xbd, 0xc3, 0xc7),
+                    .border_color = LV_COLOR_MAKE(0x7f, 0x8c, 0x8d)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+                    .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+                    .border_color = LV_COLOR_MAKE(0x29, 0x80, 0xb9)
+                }
+            }
+        }
+    },
+    .button = {
+        .border_width = 1,
+        .corner_radius = 5,
+        .pad = 5,
+        .normal = {
+            .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+            .bg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+            .border_color = LV_COLOR_MAKE(0xbd, 0xc3, 0xc7)
+        },
+        .pressed = {
+            .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+            .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+            .border_color = LV_COLOR_MAKE(0x29, 0x80, 0xb9)
+        }
+    },
+    .textarea = {
+        .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+        .bg_color = LV_COLOR_MAKE(0xfc, 0xfc, 0xfc),
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0xbd, 0xc3, 0xc7),
+        .corner_radius = 5,
+        .pad = 5,
+        .placeholder_color = LV_COLOR_MAKE(0x7f, 0x8c, 0x8d),
+        .cursor = {
+            .width = 1,
+            .color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+            .period = 700
+        }
+    },
+    .dropdown = {
+        .button = {
+            .border_width = 1,
+            .corner_radius = 5,
+            .pad = 5,
+            .normal = {
+                .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+                .bg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+                .border_color = LV_COLOR_MAKE(0xbd, 0xc3, 0xc7)
+            },
+            .pressed = {
+                .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+                .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+                .border_color = LV_COLOR_MAKE(0x29, 0x80, 0xb9)
+            }
+        },
+        .list = {
+            .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+            .bg_color = LV_COLOR_MAKE(0xfc, 0xfc, 0xfc),
+            .selection_fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+            .selection_bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+            .border_width = 1,
+            .border_color = LV_COLOR_MAKE(0xbd, 0xc3, 0xc7),
+            .corner_radius = 0,
+            .pad = 0
+        }
+    },
+    .label = {
+        .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29)
+    },
+    .msgbox = {
+        .fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+        .bg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0xbd, 0xc3, 0xc7),
+        .corner_radius = 0,
+        .pad = 20,
+        .gap = 20,
+        .dimming = {
+            .color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+            .opacity = 178
+        }
+    },
+    .bar = {
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+        .corner_radius = 5,
+        .indicator = {
+            .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9)
+        }
+    }
+};
+
+/* Breezy dark (based on KDE Breeze Dark color palette, see https://develop.kde.org/hig/style/color/dark/) */
+static const bbx_theme breezy_dark = {
+    .name = "breezy-dark",
+    .window = {
+        .bg_color = LV_COLOR_MAKE(0x31, 0x36, 0x3b)
+    },
+    .header = {
+        .bg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0x7f, 0x8c, 0x8d),
+        .pad = 10,
+        .gap = 10
+    },
+    .keyboard = {
+        .bg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0x7f, 0x8c, 0x8d),
+        .pad = 10,
+        .gap = 10,
+        .keys = {
+            .border_width = 1,
+            .corner_radius = 5,
+            .key_char = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+                    .bg_color = LV_COLOR_MAKE(0x31, 0x36, 0x3b),
+                    .border_color = LV_COLOR_MAKE(0xbd, 0xc3, 0xc7)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+                    .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+                    .border_color = LV_COLOR_MAKE(0x29, 0x80, 0xb9)
+                }
+            },
+            .key_non_char = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+                    .bg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+                    .border_color = LV_COLOR_MAKE(0x7f, 0x8c, 0x8d)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+                    .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+                    .border_color = LV_COLOR_MAKE(0x29, 0x80, 0xb9)
+                }
+            },
+            .key_mod_act = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+                    .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+                    .border_color = LV_COLOR_MAKE(0x29, 0x80, 0xb9)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+                    .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+                    .border_color = LV_COLOR_MAKE(0x29, 0x80, 0xb9)
+                }
+            },
+            .key_mod_inact = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+                    .bg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+                    .border_color = LV_COLOR_MAKE(0x7f, 0x8c, 0x8d)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+                    .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+                    .border_color = LV_COLOR_MAKE(0x29, 0x80, 0xb9)
+                }
+            }
+        }
+    },
+    .button = {
+        .border_width = 1,
+        .corner_radius = 5,
+        .pad = 5,
+        .normal = {
+            .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+            .bg_color = LV_COLOR_MAKE(0x31, 0x36, 0x3b),
+            .border_color = LV_COLOR_MAKE(0xbd, 0xc3, 0xc7)
+        },
+        .pressed = {
+            .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+            .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+            .border_color = LV_COLOR_MAKE(0x29, 0x80, 0xb9)
+        }
+    },
+    .textarea = {
+        .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+        .bg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0x7f, 0x8c, 0x8d),
+        .corner_radius = 5,
+        .pad = 5,
+        .placeholder_color = LV_COLOR_MAKE(0x7f, 0x8c, 0x8d),
+        .cursor = {
+            .width = 1,
+            .color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+            .period = 700
+        }
+    },
+    .dropdown = {
+        .button = {
+            .border_width = 1,
+            .corner_radius = 5,
+            .pad = 5,
+            .normal = {
+                .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+                .bg_color = LV_COLOR_MAKE(0x31, 0x36, 0x3b),
+                .border_color = LV_COLOR_MAKE(0xbd, 0xc3, 0xc7)
+            },
+            .pressed = {
+                .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+                .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+                .border_color = LV_COLOR_MAKE(0x29, 0x80, 0xb9)
+            }
+        },
+        .list = {
+            .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+            .bg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+            .selection_fg_color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+            .selection_bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+            .border_width = 1,
+            .border_color = LV_COLOR_MAKE(0x7f, 0x8c, 0x8d),
+            .corner_radius = 0,
+            .pad = 0
+        }
+    },
+    .label = {
+        .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1)
+    },
+    .msgbox = {
+        .fg_color = LV_COLOR_MAKE(0xef, 0xf0, 0xf1),
+        .bg_color = LV_COLOR_MAKE(0x31, 0x36, 0x3b),
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0x3b, 0x40, 0x45),
+        .corner_radius = 0,
+        .pad = 20,
+        .gap = 20,
+        .dimming = {
+            .color = LV_COLOR_MAKE(0x23, 0x26, 0x29),
+            .opacity = 178
+        }
+    },
+    .bar = {
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9),
+        .corner_radius = 5,
+        .indicator = {
+            .bg_color = LV_COLOR_MAKE(0x3d, 0xae, 0xe9)
+        }
+    }
+};
+
+/* pmOS light (based on palette https://coolors.co/009900-395e66-db504a-e3b505-ebf5ee) */
+static const bbx_theme pmos_light = {
+    .name = "pmos-light",
+    .window = {
+        .bg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8)
+    },
+    .header = {
+        .bg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+        .border_width = 0,
+        .border_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+        .pad = 20,
+        .gap = 10
+    },
+    .keyboard = {
+        .bg_color = LV_COLOR_MAKE(0xd8, 0xe6, 0xe9),
+        .border_width = 2,
+        .border_color = LV_COLOR_MAKE(0x97, 0xbc, 0xc4),
+        .pad = 20,
+        .gap = 10,
+        .keys = {
+            .border_width = 1,
+            .corner_radius = 3,
+            .key_char = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0x07, 0x0c, 0x0d),
+                    .bg_color = LV_COLOR_MAKE(0xd8, 0xe6, 0xe9),
+                    .border_color = LV_COLOR_MAKE(0x97, 0xbc, 0xc4)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+                    .bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+                    .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+                }
+            },
+            .key_non_char = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0x07, 0x0c, 0x0d),
+                    .bg_color = LV_COLOR_MAKE(0xbe, 0xd5, 0xda),
+                    .border_color = LV_COLOR_MAKE(0xb1, 0xcd, 0xd3)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+                    .bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+                    .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+                }
+            },
+            .key_mod_act = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+                    .bg_color = LV_COLOR_MAKE(0xbe, 0xd5, 0xda),
+                    .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+                    .bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+                    .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+                }
+            },
+            .key_mod_inact = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0x07, 0x0c, 0x0d),
+                    .bg_color = LV_COLOR_MAKE(0xbe, 0xd5, 0xda),
+                    .border_color = LV_COLOR_MAKE(0xb1, 0xcd, 0xd3)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+                    .bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+                    .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+                }
+            }
+        }
+    },
+    .button = {
+        .border_width = 1,
+        .corner_radius = 3,
+        .pad = 8,
+        .normal = {
+            .fg_color = LV_COLOR_MAKE(0x07, 0x0c, 0x0d),
+            .bg_color = LV_COLOR_MAKE(0xbe, 0xd5, 0xda),
+            .border_color = LV_COLOR_MAKE(0xb1, 0xcd, 0xd3)
+        },
+        .pressed = {
+            .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+            .bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+            .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+        }
+    },
+    .textarea = {
+        .fg_color = LV_COLOR_MAKE(0x07, 0x0c, 0x0d),
+        .bg_color = LV_COLOR_MAKE(0xeb, 0xff, 0xeb),
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+        .corner_radius = 3,
+        .pad = 8,
+        .placeholder_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+        .cursor = {
+            .width = 2,
+            .color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+            .period = 700
+        }
+    },
+    .dropdown = {
+        .button = {
+            .border_width = 1,
+            .corner_radius = 3,
+            .pad = 8,
+            .normal = {
+                .fg_color = LV_COLOR_MAKE(0x07, 0x0c, 0x0d),
+                .bg_color = LV_COLOR_MAKE(0xbe, 0xd5, 0xda),
+                .border_color = LV_COLOR_MAKE(0xb1, 0xcd, 0xd3)
+            },
+            .pressed = {
+                .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+                .bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+                .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+            }
+        },
+        .list = {
+            .fg_color = LV_COLOR_MAKE(0x07, 0x0c, 0x0d),
+            .bg_color = LV_COLOR_MAKE(0xd8, 0xe6, 0xe9),
+            .selection_fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+            .selection_bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+            .border_width = 1,
+            .border_color = LV_COLOR_MAKE(0x97, 0xbc, 0xc4),
+            .corner_radius = 0,
+            .pad = 8
+        }
+    },
+    .label = {
+        .fg_color = LV_COLOR_MAKE(0x07, 0x0c, 0x0d)
+    },
+    .msgbox = {
+        .fg_color = LV_COLOR_MAKE(0x07, 0x0c, 0x0d),
+        .bg_color = LV_COLOR_MAKE(0xd8, 0xe6, 0xe9),
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0x97, 0xbc, 0xc4),
+        .corner_radius = 3,
+        .pad = 20,
+        .gap = 20,
+        .dimming = {
+            .color = LV_COLOR_MAKE(0x07, 0x0c, 0x0d),
+            .opacity = 225
+        }
+    },
+    .bar = {
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+        .corner_radius = 3,
+        .indicator = {
+            .bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+        }
+    }
+};
+
+/* pmOS dark (based on palette https://coolors.co/009900-395e66-db504a-e3b505-ebf5ee) */
+static const bbx_theme pmos_dark = {
+    .name = "pmos-dark",
+    .window = {
+        .bg_color = LV_COLOR_MAKE(0x07, 0x0c, 0x0d)
+    },
+    .header = {
+        .bg_color = LV_COLOR_MAKE(0x07, 0x0c, 0x0d),
+        .border_width = 0,
+        .border_color = LV_COLOR_MAKE(0x07, 0x0c, 0x0d),
+        .pad = 20,
+        .gap = 10
+    },
+    .keyboard = {
+        .bg_color = LV_COLOR_MAKE(0x16, 0x24, 0x27),
+        .border_width = 2,
+        .border_color = LV_COLOR_MAKE(0x39, 0x5e, 0x66),
+        .pad = 20,
+        .gap = 10,
+        .keys = {
+            .border_width = 1,
+            .corner_radius = 3,
+            .key_char = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+                    .bg_color = LV_COLOR_MAKE(0x16, 0x24, 0x27),
+                    .border_color = LV_COLOR_MAKE(0x39, 0x5e, 0x66)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+                    .bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+                    .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+                }
+            },
+            .key_non_char = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+                    .bg_color = LV_COLOR_MAKE(0x25, 0x3c, 0x41),
+                    .border_color = LV_COLOR_MAKE(0x2c, 0x48, 0x4e)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+                    .bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+                    .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+                }
+            },
+            .key_mod_act = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+                    .bg_color = LV_COLOR_MAKE(0x25, 0x3c, 0x41),
+                    .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+                    .bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+                    .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+                }
+            },
+            .key_mod_inact = {
+                .normal = {
+                    .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+                    .bg_color = LV_COLOR_MAKE(0x25, 0x3c, 0x41),
+                    .border_color = LV_COLOR_MAKE(0x2c, 0x48, 0x4e)
+                },
+                .pressed = {
+                    .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+                    .bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+                    .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+                }
+            }
+        }
+    },
+    .button = {
+        .border_width = 1,
+        .corner_radius = 3,
+        .pad = 8,
+        .normal = {
+            .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+            .bg_color = LV_COLOR_MAKE(0x25, 0x3c, 0x41),
+            .border_color = LV_COLOR_MAKE(0x2c, 0x48, 0x4e)
+        },
+        .pressed = {
+            .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+            .bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+            .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+        }
+    },
+    .textarea = {
+        .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+        .bg_color = LV_COLOR_MAKE(0x00, 0x29, 0x00),
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+        .corner_radius = 3,
+        .pad = 8,
+        .placeholder_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+        .cursor = {
+            .width = 2,
+            .color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+            .period = 700
+        }
+    },
+    .dropdown = {
+        .button = {
+            .border_width = 1,
+            .corner_radius = 3,
+            .pad = 8,
+            .normal = {
+                .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+                .bg_color = LV_COLOR_MAKE(0x25, 0x3c, 0x41),
+                .border_color = LV_COLOR_MAKE(0x2c, 0x48, 0x4e)
+            },
+            .pressed = {
+                .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+                .bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+                .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+            }
+        },
+        .list = {
+            .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+            .bg_color = LV_COLOR_MAKE(0x16, 0x24, 0x27),
+            .selection_fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+            .selection_bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+            .border_width = 1,
+            .border_color = LV_COLOR_MAKE(0x39, 0x5e, 0x66),
+            .corner_radius = 0,
+            .pad = 8
+        }
+    },
+    .label = {
+        .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8)
+    },
+    .msgbox = {
+        .fg_color = LV_COLOR_MAKE(0xf2, 0xf7, 0xf8),
+        .bg_color = LV_COLOR_MAKE(0x16, 0x24, 0x27),
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0x39, 0x5e, 0x66),
+        .corner_radius = 3,
+        .pad = 20,
+        .gap = 20,
+        .dimming = {
+            .color = LV_COLOR_MAKE(0x07, 0x0c, 0x0d),
+            .opacity = 225
+        }
+    },
+    .bar = {
+        .border_width = 1,
+        .border_color = LV_COLOR_MAKE(0x00, 0x99, 0x00),
+        .corner_radius = 3,
+        .indicator = {
+            .bg_color = LV_COLOR_MAKE(0x00, 0x99, 0x00)
+        }
+    }
+};
+
+
+/* Theme IDs need to match the order of the themes */
+_Static_assert(BBX_THEMES_THEME_BREEZY_LIGHT == 0, "Unexpected ID for theme breezy-light");
+_Static_assert(BBX_THEMES_THEME_BREEZY_DARK == 1, "Unexpected ID for theme breezy-dark");
+_Static_assert(BBX_THEMES_THEME_PMOS_LIGHT == 2, "Unexpected ID for theme pmos-light");
+_Static_assert(BBX_THEMES_THEME_PMOS_DARK == 3, "Unexpected ID for theme pmos-dark");
+
+const int bbx_themes_num_themes = 4;
+const bbx_theme *bbx_themes_themes[] = {
+    &breezy_light,
+    &breezy_dark,
+    &pmos_light,
+    &pmos_dark
+};
+
+const uint32_t bbx_themes_name_hash_seed = 2166136261u;
+const int bbx_themes_name_hash_size = 9;
+const bbx_themes_theme_id_t bbx_themes_name_hash_slots[] = {
+    BBX_THEMES_THEME_BREEZY_LIGHT,
+    BBX_THEMES_THEME_NONE,
+    BBX_THEMES_THEME_NONE,
+    BBX_THEMES_THEME_BREEZY_DARK,
+    BBX_THEMES_THEME_PMOS_LIGHT,
+    BBX_THEMES_THEME_PMOS_DARK,
+    BBX_THEMES_THEME_NONE,
+    BBX_THEMES_THEME_NONE,
+    BBX_THEMES_THEME_NONE
+};
@@ -0,0 +1,21 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#ifndef BBX_THEMES_BUILTIN_H
+#define BBX_THEMES_BUILTIN_H
+
+#include "../themes.h"
+
+#include <stdint.h>
+
+/* Perfect hash table of the built-in theme names, generated into builtin.c by compile-theme.py. A name
+ * hashes to slot hash_name(name, bbx_themes_name_hash_seed) % bbx_themes_name_hash_size, which holds
+ * the ID of the only built-in theme that can have the name or BBX_THEMES_THEME_NONE. */
+extern const uint32_t bbx_themes_name_hash_seed;
+extern const int bbx_themes_name_hash_size;
+extern const bbx_themes_theme_id_t bbx_themes_name_hash_slots[];
+
+#endif /* BBX_THEMES_BUILTIN_H */
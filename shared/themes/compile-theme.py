@@ -0,0 +1,472 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 Johannes Marbach
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+
+import argparse
+import configparser
+import struct
+import sys
+
+
+###
+# Global constants
+
+# Binary file format, needs to be kept in sync with struct file_header in themes.c
+file_magic = b'BBXT'
+file_version = 1
+header_format = '<4sIIII'
+
+# Name hashing, needs to be kept in sync with hash_name in themes.c
+hash_offset_basis = 2166136261
+hash_prime = 16777619
+max_hash_seeds = 1000000
+
+# Theme fields in file order, needs to be kept in sync with theme_fields in themes.c
+fields = [
+    'window.bg_color',
+    'header.bg_color',
+    'header.border_width',
+    'header.border_color',
+    'header.pad',
+    'header.gap',
+    'keyboard.bg_color',
+    'keyboard.border_width',
+    'keyboard.border_color',
+    'keyboard.pad',
+    'keyboard.gap',
+    'keyboard.keys.border_width',
+    'keyboard.keys.corner_radius',
+    'keyboard.keys.key_char.normal.fg_color',
+    'keyboard.keys.key_char.normal.bg_color',
+    'keyboard.keys.key_char.normal.border_color',
+    'keyboard.keys.key_char.pressed.fg_color',
+    'keyboard.keys.key_char.pressed.bg_color',
+    'keyboard.keys.key_char.pressed.border_color',
+    'keyboard.keys.key_non_char.normal.fg_color',
+    'keyboard.keys.key_non_char.normal.bg_color',
+    'keyboard.keys.key_non_char.normal.border_color',
+    'keyboard.keys.key_non_char.pressed.fg_color',
+    'keyboard.keys.key_non_char.pressed.bg_color',
+    'keyboard.keys.key_non_char.pressed.border_color',
+    'keyboard.keys.key_mod_act.normal.fg_color',
+    'keyboard.keys.key_mod_act.normal.bg_color',
+    'keyboard.keys.key_mod_act.normal.border_color',
+    'keyboard.keys.key_mod_act.pressed.fg_color',
+    'keyboard.keys.key_mod_act.pressed.bg_color',
+    'keyboard.keys.key_mod_act.pressed.border_color',
+    'keyboard.keys.key_mod_inact.normal.fg_color',
+    'keyboard.keys.key_mod_inact.normal.bg_color',
+    'keyboard.keys.key_mod_inact.normal.border_color',
+    'keyboard.keys.key_mod_inact.pressed.fg_color',
+    'keyboard.keys.key_mod_inact.pressed.bg_color',
+    'keyboard.keys.key_mod_inact.pressed.border_color',
+    'button.border_width',
+    'button.corner_radius',
+    'button.pad',
+    'button.normal.fg_color',
+    'button.normal.bg_color',
+    'button.normal.border_color',
+    'button.pressed.fg_color',
+    'button.pressed.bg_color',
+    'button.pressed.border_color',
+    'textarea.fg_color',
+    'textarea.bg_color',
+    'textarea.border_width',
+    'textarea.border_color',
+    'textarea.corner_radius',
+    'textarea.pad',
+    'textarea.placeholder_color',
+    'textarea.cursor.width',
+    'textarea.cursor.color',
+    'textarea.cursor.period',
+    'dropdown.button.border_width',
+    'dropdown.button.corner_radius',
+    'dropdown.button.pad',
+    'dropdown.button.normal.fg_color',
+    'dropdown.button.normal.bg_color',
+    'dropdown.button.normal.border_color',
+    'dropdown.button.pressed.fg_color',
+    'dropdown.button.pressed.bg_color',
+    'dropdown.button.pressed.border_color',
+    'dropdown.list.fg_color',
+    'dropdown.list.bg_color',
+    'dropdown.list.selection_fg_color',
+    'dropdown.list.selection_bg_color',
+    'dropdown.list.border_width',
+    'dropdown.list.border_color',
+    'dropdown.list.corner_radius',
+    'dropdown.list.pad',
+    'label.fg_color',
+    'msgbox.fg_color',
+    'msgbox.bg_color',
+    'msgbox.border_width',
+    'msgbox.border_color',
+    'msgbox.corner_radius',
+    'msgbox.pad',
+    'msgbox.gap',
+    'msgbox.dimming.color',
+    'msgbox.dimming.opacity',
+    'bar.border_width',
+    'bar.border_color',
+    'bar.corner_radius',
+    'bar.indicator.bg_color'
+]
+
+# Foreground / background color pairs that need to be legible. Each pair is checked in every
+# listed state.
+contrast_pairs = [
+    ('keyboard.keys.key_char', ['normal', 'pressed'], 'fg_color', 'bg_color'),
+    ('keyboard.keys.key_non_char', ['normal', 'pressed'], 'fg_color', 'bg_color'),
+    ('keyboard.keys.key_mod_act', ['normal', 'pressed'], 'fg_color', 'bg_color'),
+    ('keyboard.keys.key_mod_inact', ['normal', 'pressed'], 'fg_color', 'bg_color'),
+    ('button', ['normal', 'pressed'], 'fg_color', 'bg_color'),
+    ('dropdown.button', ['normal', 'pressed'], 'fg_color', 'bg_color'),
+    ('textarea', [None], 'fg_color', 'bg_color'),
+    ('dropdown.list', [None], 'fg_color', 'bg_color'),
+    ('dropdown.list', [None], 'selection_fg_color', 'selection_bg_color'),
+    ('msgbox', [None], 'fg_color', 'bg_color')
+]
+
+# Labels are drawn directly onto the window
+extra_contrast_pairs = [
+    ('label.fg_color', 'window.bg_color')
+]
+
+
+###
+# General helpers
+##
+
+def die(msg):
+    """Print an error message to STDERR and exit with a non-zero code.
+
+    msg -- message to output on STDERR
+    """
+    sys.stderr.write(msg if msg.endswith('\n') else msg + '\n')
+    sys.exit(1)
+
+
+def parse_arguments():
+    """ Parse commandline arguments.
+    """
+    parser = argparse.ArgumentParser(description='Validate themes and compile them into a binary theme file or into '
+                                     + 'C source code for the built-in themes.')
+    parser.add_argument('inputs', nargs='+', metavar='input', help='theme file in INI format.')
+    output = parser.add_mutually_exclusive_group(required=True)
+    output.add_argument('-o', '--output', dest='output', help='path of the binary theme file to write. Requires '
+                        + 'exactly one input.')
+    output.add_argument('--c', dest='c_output', help='path of the C source file with the built-in themes to write. '
+                        + 'Themes are numbered in the order of the inputs.')
+    parser.add_argument('--min-contrast', dest='min_contrast', type=float, default=2.0, help='minimum contrast ratio '
+                        + 'between foreground and background colors (default: 2.0).')
+
+    args = parser.parse_args()
+    if args.output and len(args.inputs) != 1:
+        parser.error('--output requires exactly one input')
+    return args
+
+
+###
+# Theme parsing
+##
+
+def parse_theme(path):
+    """Return the name, description and a dictionary mapping field paths to values of a theme in INI format.
+
+    path -- path to the theme file
+    """
+    parser = configparser.ConfigParser(interpolation=None)
+    parser.optionxform = str
+    try:
+        with open(path, 'r', encoding='utf-8') as fp:
+            parser.read_file(fp)
+    except (OSError, configparser.Error) as e:
+        die(f'Could not read {path}: {e}')
+
+    if not parser.has_option('theme', 'name'):
+        die(f'Missing name in [theme] section of {path}')
+    name = parser.get('theme', 'name')
+    description = parser.get('theme', 'description', fallback=None)
+
+    values = {}
+    for section in parser.sections():
+        if section == 'theme':
+            continue
+        for key, value in parser.items(section):
+            field = f'{section}.{key}'
+            if field not in fields:
+                die(f'Unknown field {key} in section [{section}]')
+            try:
+                values[field] = int(value, 0)
+            except ValueError:
+                die(f'Invalid value {value} for {key} in section [{section}]')
+
+    return name, description, values
+
+
+###
+# Validation
+##
+
+def validate_completeness(values):
+    """Abort if a field is missing.
+
+    values -- dictionary mapping field paths to values
+    """
+    missing = [field for field in fields if field not in values]
+    if missing:
+        die('Missing fields: ' + ', '.join(missing))
+
+
+def validate_ranges(values):
+    """Abort if a value is out of range for its field.
+
+    values -- dictionary mapping field paths to values
+    """
+    for field in fields:
+        value = values[field]
+        if field.endswith('color'):
+            valid = 0 <= value <= 0xFFFFFF
+        elif field.endswith('opacity'):
+            valid = 0 <= value <= 255
+        else:
+            valid = 0 <= value <= 0x7FFFFFFF
+        if not valid:
+            die(f'Value {value} is out of range for {field}')
+
+
+def relative_luminance(color):
+    """Return the WCAG relative luminance of an RGB color.
+
+    color -- color in 0xRRGGBB format
+    """
+    def channel(c):
+        c /= 255
+        return c / 12.92 if c <= 0.03928 else ((c + 0.055) / 1.055) ** 2.4
+    return 0.2126 * channel((color >> 16) & 0xFF) + 0.7152 * channel((color >> 8) & 0xFF) + 0.0722 * channel(color & 0xFF)
+
+
+def contrast_ratio(color1, color2):
+    """Return the WCAG contrast ratio between two RGB colors.
+
+    color1 -- first color in 0xRRGGBB format
+    color2 -- second color in 0xRRGGBB format
+    """
+    l1, l2 = sorted([relative_luminance(color1), relative_luminance(color2)], reverse=True)
+    return (l1 + 0.05) / (l2 + 0.05)
+
+
+def validate_contrast(values, min_contrast):
+    """Abort if a foreground color has too little contrast against its background.
+
+    values -- dictionary mapping field paths to values
+    min_contrast -- minimum contrast ratio
+    """
+    pairs = list(extra_contrast_pairs)
+    for prefix, states, fg, bg in contrast_pairs:
+        for state in states:
+            path = prefix if state is None else f'{prefix}.{state}'
+            pairs.append((f'{path}.{fg}', f'{path}.{bg}'))
+
+    for fg, bg in pairs:
+        ratio = contrast_ratio(values[fg], values[bg])
+        if ratio < min_contrast:
+            die(f'Contrast ratio {ratio:.2f} between {fg} and {bg} is below {min_contrast:.2f}')
+
+
+###
+# Output
+##
+
+def write_theme(path, name, values):
+    """Write a binary theme file.
+
+    path -- path of the file to write
+    name -- theme name
+    values -- dictionary mapping field paths to values
+    """
+    data = b''.join(struct.pack('<I', values[field]) for field in fields)
+    name_offset = struct.calcsize(header_format) + len(data)
+    encoded_name = name.encode('utf-8') + b'\0'
+    size = name_offset + len(encoded_name)
+    header = struct.pack(header_format, file_magic, file_version, size, name_offset, len(fields))
+
+    try:
+        with open(path, 'wb') as fp:
+            fp.write(header + data + encoded_name)
+    except OSError as e:
+        die(f'Could not write {path}: {e}')
+
+
+def name_hash(name, seed):
+    """Return the FNV-1a hash of a theme name.
+
+    name -- theme name
+    seed -- initial hash value
+    """
+    h = seed
+    for byte in name.encode('utf-8'):
+        h = ((h ^ byte) * hash_prime) & 0xFFFFFFFF
+    return h
+
+
+def build_hash_table(names):
+    """Return the seed and slots of a perfect hash table for a list of theme names. Slots hold the name's index
+    or None.
+
+    names -- list of theme names
+    """
+    # The low bits of FNV-1a hardly depend on the seed, so use an odd table size
+    size = 2 * len(names) + 1
+
+    for seed in range(hash_offset_basis, hash_offset_basis + max_hash_seeds):
+        slots = [None] * size
+        for index, name in enumerate(names):
+            slot = name_hash(name, seed) % size
+            if slots[slot] is not None:
+                break
+            slots[slot] = index
+        else:
+            return seed, slots
+
+    die('Could not find a perfect hash for the theme names')
+
+
+def c_identifier(name):
+    """Return a C identifier for a theme name.
+
+    name -- theme name
+    """
+    return ''.join(c if c.isalnum() else '_' for c in name.lower())
+
+
+def c_theme_id(name):
+    """Return the theme's constant in bbx_themes_theme_id_t.
+
+    name -- theme name
+    """
+    return 'BBX_THEMES_THEME_' + c_identifier(name).upper()
+
+
+def c_value(field, value):
+    """Return the C initialiser for a field value.
+
+    field -- field path
+    value -- field value
+    """
+    if field.endswith('color'):
+        return f'LV_COLOR_MAKE(0x{(value >> 16) & 0xFF:02x}, 0x{(value >> 8) & 0xFF:02x}, 0x{value & 0xFF:02x})'
+    return str(value)
+
+
+def c_initialiser(name, values):
+    """Return the lines of the designated initialiser for a theme.
+
+    name -- theme name
+    values -- dictionary mapping field paths to values
+    """
+    # Group fields into nested structs, preserving field order
+    tree = {}
+    for field in fields:
+        node = tree
+        *parents, member = field.split('.')
+        for parent in parents:
+            node = node.setdefault(parent, {})
+        node[member] = c_value(field, values[field])
+
+    def emit(node, indent):
+        items = list(node.items())
+        lines = []
+        for i, (member, value) in enumerate(items):
+            separator = ',' if i < len(items) - 1 else ''
+            if isinstance(value, dict):
+                lines.append(f'{indent}.{member} = {{')
+                lines += emit(value, indent + '    ')
+                lines.append(f'{indent}}}{separator}')
+            else:
+                lines.append(f'{indent}.{member} = {value}{separator}')
+        return lines
+
+    return [f'    .name = "{name}",'] + emit(tree, '    ')
+
+
+def write_c(path, themes):
+    """Write a C source file with the built-in themes.
+
+    path -- path of the file to write
+    themes -- list of (name, description, values) tuples
+    """
+    names = [name for name, _, _ in themes]
+    seed, slots = build_hash_table(names)
+
+    lines = [
+        '/**',
+        ' * Auto-generated with compile-theme.py',
+        ' **/',
+        '',
+        '#include "builtin.h"',
+        ''
+    ]
+
+    for name, description, values in themes:
+        lines.append('')
+        if description:
+            lines.append(f'/* {description} */')
+        lines.append(f'static const bbx_theme {c_identifier(name)} = {{')
+        lines += c_initialiser(name, values)
+        lines.append('};')
+
+    lines += [
+        '',
+        '',
+        '/* Theme IDs need to match the order of the themes */'
+    ]
+    for index, name in enumerate(names):
+        lines.append(f'_Static_assert({c_theme_id(name)} == {index}, "Unexpected ID for theme {name}");')
+
+    lines += [
+        '',
+        f'const int bbx_themes_num_themes = {len(themes)};',
+        'const bbx_theme *bbx_themes_themes[] = {',
+        ',\n'.join(f'    &{c_identifier(name)}' for name in names),
+        '};',
+        '',
+        f'const uint32_t bbx_themes_name_hash_seed = {seed}u;',
+        f'const int bbx_themes_name_hash_size = {len(slots)};',
+        'const bbx_themes_theme_id_t bbx_themes_name_hash_slots[] = {',
+        ',\n'.join('    ' + ('BBX_THEMES_THEME_NONE' if index is None else c_theme_id(names[index]))
+                   for index in slots),
+        '};'
+    ]
+
+    try:
+        with open(path, 'w', encoding='utf-8') as fp:
+            fp.write('\n'.join(lines) + '\n')
+    except OSError as e:
+        die(f'Could not write {path}: {e}')
+
+
+###
+# Main
+##
+
+if __name__ == '__main__':
+    args = parse_arguments()
+
+    themes = []
+    for path in args.inputs:
+        name, description, values = parse_theme(path)
+        validate_completeness(values)
+        validate_ranges(values)
+        validate_contrast(values, args.min_contrast)
+        if any(name == other for other, _, _ in themes):
+            die(f'Duplicate theme name {name} in {path}')
+        themes.append((name, description, values))
+
+    if args.output:
+        name, _, values = themes[0]
+        write_theme(args.output, name, values)
+    else:
+        write_c(args.c_output, themes)
@@ -0,0 +1,9 @@
+#!/bin/sh -ex
+
+# Copyright 2026 Johannes Marbach
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+# Validates the built-in themes and generates builtin.c from them. The order of the themes needs to
+# match bbx_themes_theme_id_t in ../themes.h.
+
+./compile-theme.py --c builtin.c breezy-light.ini breezy-dark.ini pmos-light.ini pmos-dark.ini
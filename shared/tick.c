@@ -0,0 +1,66 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#include "tick.h"
+
+#include <time.h>
+
+
+/**
+ * Static variables
+ */
+
+static uint64_t start_ms = 0;
+
+
+/**
+ * Static prototypes
+ */
+
+/**
+ * Get the current time from the monotonic clock.
+ *
+ * @return time in ms
+ */
+static uint64_t now_ms(void);
+
+
+/**
+ * Static functions
+ */
+
+static uint64_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+
+/**
+ * Public functions
+ */
+
+uint32_t bbx_tick_get(void) {
+    if (start_ms == 0) {
+        start_ms = now_ms();
+    }
+    return (uint32_t)(now_ms() - start_ms);
+}
+
+void bbx_tick_to_timeval(uint32_t tick, struct timeval *time) {
+    if (start_ms == 0) {
+        start_ms = now_ms();
+    }
+    uint64_t ms = start_ms + tick;
+    time->tv_sec = ms / 1000;
+    time->tv_usec = (ms % 1000) * 1000;
+}
+
+uint64_t bbx_tick_get_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
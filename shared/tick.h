@@ -0,0 +1,38 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#ifndef BBX_TICK_H
+#define BBX_TICK_H
+
+#include <stdint.h>
+
+#include <sys/time.h>
+
+/**
+ * Get the number of milliseconds elapsed since the first call, measured on the monotonic
+ * clock so that wall clock adjustments don't affect it. Suitable for use with lv_tick_set_cb.
+ *
+ * @return tick in ms
+ */
+uint32_t bbx_tick_get(void);
+
+/**
+ * Convert a tick obtained from bbx_tick_get into an absolute CLOCK_MONOTONIC timestamp.
+ *
+ * @param tick tick in ms
+ * @param time pointer to write the timestamp into
+ */
+void bbx_tick_to_timeval(uint32_t tick, struct timeval *time);
+
+/**
+ * Get the current time from the monotonic clock with microsecond resolution. Meant for measuring
+ * durations, the absolute value is unrelated to bbx_tick_get.
+ *
+ * @return time in µs
+ */
+uint64_t bbx_tick_get_us(void);
+
+#endif /* BBX_TICK_H */
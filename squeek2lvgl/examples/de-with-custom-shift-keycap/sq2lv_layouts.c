@@ -45,6 +45,13 @@ static const int switcher_dests_lower_de[] = { \
     1, 2, 4 \
 };
 
+static const uint8_t key_classes_lower_de[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 1, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Uppercase letters - generated from upper */
 
 static const int num_keys_upper_de = 36;
@@ -77,6 +84,13 @@ static const int switcher_dests_upper_de[] = { \
     0, 2, 4 \
 };
 
+static const uint8_t key_classes_upper_de[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Numbers / symbols - generated from numbers */
 
 static const int num_keys_numbers_de = 37;
@@ -109,6 +123,13 @@ static const int switcher_dests_numbers_de[] = { \
     3, 0, 4 \
 };
 
+static const uint8_t key_classes_numbers_de[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 3, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Symbols - generated from symbols */
 
 static const int num_keys_symbols_de = 37;
@@ -141,6 +162,13 @@ static const int switcher_dests_symbols_de[] = { \
     2, 0, 4 \
 };
 
+static const uint8_t key_classes_symbols_de[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Special characters - generated from eschars */
 
 static const int num_keys_special_de = 37;
@@ -173,6 +201,13 @@ static const int switcher_dests_special_de[] = { \
     2, 0, 0 \
 };
 
+static const uint8_t key_classes_special_de[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer array */
 
 static const int num_layers_de = 5;
@@ -186,7 +221,8 @@ static const sq2lv_layer_t layers_de[] = {
         .modifier_idxs = modifier_idxs_lower_de,
         .num_switchers = num_switchers_lower_de,
         .switcher_idxs = switcher_idxs_lower_de,
-        .switcher_dests = switcher_dests_lower_de
+        .switcher_dests = switcher_dests_lower_de,
+        .key_classes = key_classes_lower_de
     },
     {
         .num_keys = num_keys_upper_de,
@@ -196,7 +232,8 @@ static const sq2lv_layer_t layers_de[] = {
         .modifier_idxs = modifier_idxs_upper_de,
         .num_switchers = num_switchers_upper_de,
         .switcher_idxs = switcher_idxs_upper_de,
-        .switcher_dests = switcher_dests_upper_de
+        .switcher_dests = switcher_dests_upper_de,
+        .key_classes = key_classes_upper_de
     },
     {
         .num_keys = num_keys_numbers_de,
@@ -206,7 +243,8 @@ static const sq2lv_layer_t layers_de[] = {
         .modifier_idxs = modifier_idxs_numbers_de,
         .num_switchers = num_switchers_numbers_de,
         .switcher_idxs = switcher_idxs_numbers_de,
-        .switcher_dests = switcher_dests_numbers_de
+        .switcher_dests = switcher_dests_numbers_de,
+        .key_classes = key_classes_numbers_de
     },
     {
         .num_keys = num_keys_symbols_de,
@@ -216,7 +254,8 @@ static const sq2lv_layer_t layers_de[] = {
         .modifier_idxs = modifier_idxs_symbols_de,
         .num_switchers = num_switchers_symbols_de,
         .switcher_idxs = switcher_idxs_symbols_de,
-        .switcher_dests = switcher_dests_symbols_de
+        .switcher_dests = switcher_dests_symbols_de,
+        .key_classes = key_classes_symbols_de
     },
     {
         .num_keys = num_keys_special_de,
@@ -226,7 +265,8 @@ static const sq2lv_layer_t layers_de[] = {
         .modifier_idxs = modifier_idxs_special_de,
         .num_switchers = num_switchers_special_de,
         .switcher_idxs = switcher_idxs_special_de,
-        .switcher_dests = switcher_dests_special_de
+        .switcher_dests = switcher_dests_special_de,
+        .key_classes = key_classes_special_de
     }
 };
 
@@ -45,6 +45,13 @@ static const int switcher_dests_lower_es[] = { \
     1, 2, 4 \
 };
 
+static const uint8_t key_classes_lower_es[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 1, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Uppercase letters - generated from upper */
 
 static const int num_keys_upper_es = 37;
@@ -77,6 +84,13 @@ static const int switcher_dests_upper_es[] = { \
     0, 2, 4 \
 };
 
+static const uint8_t key_classes_upper_es[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Numbers / symbols - generated from numbers */
 
 static const int num_keys_numbers_es = 37;
@@ -109,6 +123,13 @@ static const int switcher_dests_numbers_es[] = { \
     3, 0, 4 \
 };
 
+static const uint8_t key_classes_numbers_es[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 3, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Symbols - generated from symbols */
 
 static const int num_keys_symbols_es = 37;
@@ -141,6 +162,13 @@ static const int switcher_dests_symbols_es[] = { \
     2, 0, 4 \
 };
 
+static const uint8_t key_classes_symbols_es[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Special characters - generated from eschars */
 
 static const int num_keys_special_es = 37;
@@ -173,6 +201,13 @@ static const int switcher_dests_special_es[] = { \
     2, 0, 0 \
 };
 
+static const uint8_t key_classes_special_es[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer array */
 
 static const int num_layers_es = 5;
@@ -186,7 +221,8 @@ static const sq2lv_layer_t layers_es[] = {
         .modifier_idxs = modifier_idxs_lower_es,
         .num_switchers = num_switchers_lower_es,
         .switcher_idxs = switcher_idxs_lower_es,
-        .switcher_dests = switcher_dests_lower_es
+        .switcher_dests = switcher_dests_lower_es,
+        .key_classes = key_classes_lower_es
     },
     {
         .num_keys = num_keys_upper_es,
@@ -196,7 +232,8 @@ static const sq2lv_layer_t layers_es[] = {
         .modifier_idxs = modifier_idxs_upper_es,
         .num_switchers = num_switchers_upper_es,
         .switcher_idxs = switcher_idxs_upper_es,
-        .switcher_dests = switcher_dests_upper_es
+        .switcher_dests = switcher_dests_upper_es,
+        .key_classes = key_classes_upper_es
     },
     {
         .num_keys = num_keys_numbers_es,
@@ -206,7 +243,8 @@ static const sq2lv_layer_t layers_es[] = {
         .modifier_idxs = modifier_idxs_numbers_es,
         .num_switchers = num_switchers_numbers_es,
         .switcher_idxs = switcher_idxs_numbers_es,
-        .switcher_dests = switcher_dests_numbers_es
+        .switcher_dests = switcher_dests_numbers_es,
+        .key_classes = key_classes_numbers_es
     },
     {
         .num_keys = num_keys_symbols_es,
@@ -216,7 +254,8 @@ static const sq2lv_layer_t layers_es[] = {
         .modifier_idxs = modifier_idxs_symbols_es,
         .num_switchers = num_switchers_symbols_es,
         .switcher_idxs = switcher_idxs_symbols_es,
-        .switcher_dests = switcher_dests_symbols_es
+        .switcher_dests = switcher_dests_symbols_es,
+        .key_classes = key_classes_symbols_es
     },
     {
         .num_keys = num_keys_special_es,
@@ -226,7 +265,8 @@ static const sq2lv_layer_t layers_es[] = {
         .modifier_idxs = modifier_idxs_special_es,
         .num_switchers = num_switchers_special_es,
         .switcher_idxs = switcher_idxs_special_es,
-        .switcher_dests = switcher_dests_special_es
+        .switcher_dests = switcher_dests_special_es,
+        .key_classes = key_classes_special_es
     }
 };
 
@@ -269,6 +309,13 @@ static const int switcher_dests_lower_fr[] = { \
     1, 2, 4 \
 };
 
+static const uint8_t key_classes_lower_fr[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 1, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0 \
+};
+
 /* Layer: Uppercase letters - generated from upper */
 
 static const int num_keys_upper_fr = 35;
@@ -301,6 +348,13 @@ static const int switcher_dests_upper_fr[] = { \
     0, 2, 4 \
 };
 
+static const uint8_t key_classes_upper_fr[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0 \
+};
+
 /* Layer: Numbers / symbols - generated from numbers */
 
 static const int num_keys_numbers_fr = 35;
@@ -333,6 +387,13 @@ static const int switcher_dests_numbers_fr[] = { \
     3, 0, 4 \
 };
 
+static const uint8_t key_classes_numbers_fr[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 3, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0 \
+};
+
 /* Layer: Symbols - generated from symbols */
 
 static const int num_keys_symbols_fr = 35;
@@ -365,6 +426,13 @@ static const int switcher_dests_symbols_fr[] = { \
     2, 0, 4 \
 };
 
+static const uint8_t key_classes_symbols_fr[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0 \
+};
+
 /* Layer: Special characters - generated from eschars */
 
 static const int num_keys_special_fr = 35;
@@ -397,6 +465,13 @@ static const int switcher_dests_special_fr[] = { \
     2, 0, 0 \
 };
 
+static const uint8_t key_classes_special_fr[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, SQ2LV_KEY_CLASS_SWITCHER | 0, 0 \
+};
+
 /* Layer array */
 
 static const int num_layers_fr = 5;
@@ -410,7 +485,8 @@ static const sq2lv_layer_t layers_fr[] = {
         .modifier_idxs = modifier_idxs_lower_fr,
         .num_switchers = num_switchers_lower_fr,
         .switcher_idxs = switcher_idxs_lower_fr,
-        .switcher_dests = switcher_dests_lower_fr
+        .switcher_dests = switcher_dests_lower_fr,
+        .key_classes = key_classes_lower_fr
     },
     {
         .num_keys = num_keys_upper_fr,
@@ -420,7 +496,8 @@ static const sq2lv_layer_t layers_fr[] = {
         .modifier_idxs = modifier_idxs_upper_fr,
         .num_switchers = num_switchers_upper_fr,
         .switcher_idxs = switcher_idxs_upper_fr,
-        .switcher_dests = switcher_dests_upper_fr
+        .switcher_dests = switcher_dests_upper_fr,
+        .key_classes = key_classes_upper_fr
     },
     {
         .num_keys = num_keys_numbers_fr,
@@ -430,7 +507,8 @@ static const sq2lv_layer_t layers_fr[] = {
         .modifier_idxs = modifier_idxs_numbers_fr,
         .num_switchers = num_switchers_numbers_fr,
         .switcher_idxs = switcher_idxs_numbers_fr,
-        .switcher_dests = switcher_dests_numbers_fr
+        .switcher_dests = switcher_dests_numbers_fr,
+        .key_classes = key_classes_numbers_fr
     },
     {
         .num_keys = num_keys_symbols_fr,
@@ -440,7 +518,8 @@ static const sq2lv_layer_t layers_fr[] = {
         .modifier_idxs = modifier_idxs_symbols_fr,
         .num_switchers = num_switchers_symbols_fr,
         .switcher_idxs = switcher_idxs_symbols_fr,
-        .switcher_dests = switcher_dests_symbols_fr
+        .switcher_dests = switcher_dests_symbols_fr,
+        .key_classes = key_classes_symbols_fr
     },
     {
         .num_keys = num_keys_special_fr,
@@ -450,7 +529,8 @@ static const sq2lv_layer_t layers_fr[] = {
         .modifier_idxs = modifier_idxs_special_fr,
         .num_switchers = num_switchers_special_fr,
         .switcher_idxs = switcher_idxs_special_fr,
-        .switcher_dests = switcher_dests_special_fr
+        .switcher_dests = switcher_dests_special_fr,
+        .key_classes = key_classes_special_fr
     }
 };
 
@@ -493,6 +573,13 @@ static const int switcher_dests_lower_us[] = { \
     1, 2 \
 };
 
+static const uint8_t key_classes_lower_us[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 1, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Uppercase letters - generated from upper */
 
 static const int num_keys_upper_us = 34;
@@ -525,6 +612,13 @@ static const int switcher_dests_upper_us[] = { \
     0, 2 \
 };
 
+static const uint8_t key_classes_upper_us[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Numbers / symbols - generated from numbers */
 
 static const int num_keys_numbers_us = 35;
@@ -557,6 +651,13 @@ static const int switcher_dests_numbers_us[] = { \
     3, 0 \
 };
 
+static const uint8_t key_classes_numbers_us[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 3, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Symbols - generated from symbols */
 
 static const int num_keys_symbols_us = 35;
@@ -589,6 +690,13 @@ static const int switcher_dests_symbols_us[] = { \
     2, 0 \
 };
 
+static const uint8_t key_classes_symbols_us[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer array */
 
 static const int num_layers_us = 4;
@@ -602,7 +710,8 @@ static const sq2lv_layer_t layers_us[] = {
         .modifier_idxs = modifier_idxs_lower_us,
         .num_switchers = num_switchers_lower_us,
         .switcher_idxs = switcher_idxs_lower_us,
-        .switcher_dests = switcher_dests_lower_us
+        .switcher_dests = switcher_dests_lower_us,
+        .key_classes = key_classes_lower_us
     },
     {
         .num_keys = num_keys_upper_us,
@@ -612,7 +721,8 @@ static const sq2lv_layer_t layers_us[] = {
         .modifier_idxs = modifier_idxs_upper_us,
         .num_switchers = num_switchers_upper_us,
         .switcher_idxs = switcher_idxs_upper_us,
-        .switcher_dests = switcher_dests_upper_us
+        .switcher_dests = switcher_dests_upper_us,
+        .key_classes = key_classes_upper_us
     },
     {
         .num_keys = num_keys_numbers_us,
@@ -622,7 +732,8 @@ static const sq2lv_layer_t layers_us[] = {
         .modifier_idxs = modifier_idxs_numbers_us,
         .num_switchers = num_switchers_numbers_us,
         .switcher_idxs = switcher_idxs_numbers_us,
-        .switcher_dests = switcher_dests_numbers_us
+        .switcher_dests = switcher_dests_numbers_us,
+        .key_classes = key_classes_numbers_us
     },
     {
         .num_keys = num_keys_symbols_us,
@@ -632,7 +743,8 @@ static const sq2lv_layer_t layers_us[] = {
         .modifier_idxs = modifier_idxs_symbols_us,
         .num_switchers = num_switchers_symbols_us,
         .switcher_idxs = switcher_idxs_symbols_us,
-        .switcher_dests = switcher_dests_symbols_us
+        .switcher_dests = switcher_dests_symbols_us,
+        .key_classes = key_classes_symbols_us
     }
 };
 
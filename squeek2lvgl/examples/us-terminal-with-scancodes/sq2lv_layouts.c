@@ -50,6 +50,14 @@ static const int switcher_dests_lower_terminal_us[] = { \
     1, 2, 4 \
 };
 
+static const uint8_t key_classes_lower_terminal_us[] = { \
+    SQ2LV_KEY_CLASS_MODIFIER, SQ2LV_KEY_CLASS_MODIFIER, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 1, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0 \
+};
+
 static const int num_scancodes_lower_terminal_us = 5;
 
 static const int scancodes_lower_terminal_us[] = { \
@@ -112,6 +120,14 @@ static const int switcher_dests_upper_terminal_us[] = { \
     0, 2, 4 \
 };
 
+static const uint8_t key_classes_upper_terminal_us[] = { \
+    SQ2LV_KEY_CLASS_MODIFIER, SQ2LV_KEY_CLASS_MODIFIER, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0 \
+};
+
 static const int num_scancodes_upper_terminal_us = 5;
 
 static const int scancodes_upper_terminal_us[] = { \
@@ -174,6 +190,14 @@ static const int switcher_dests_numbers_terminal_us[] = { \
     3, 0 \
 };
 
+static const uint8_t key_classes_numbers_terminal_us[] = { \
+    SQ2LV_KEY_CLASS_MODIFIER, SQ2LV_KEY_CLASS_MODIFIER, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 3, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0 \
+};
+
 static const int num_scancodes_numbers_terminal_us = 5;
 
 static const int scancodes_numbers_terminal_us[] = { \
@@ -236,6 +260,14 @@ static const int switcher_dests_symbols_terminal_us[] = { \
     2, 0 \
 };
 
+static const uint8_t key_classes_symbols_terminal_us[] = { \
+    SQ2LV_KEY_CLASS_MODIFIER, SQ2LV_KEY_CLASS_MODIFIER, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0 \
+};
+
 static const int num_scancodes_symbols_terminal_us = 5;
 
 static const int scancodes_symbols_terminal_us[] = { \
@@ -298,6 +330,14 @@ static const int switcher_dests_actions_terminal_us[] = { \
     0 \
 };
 
+static const uint8_t key_classes_actions_terminal_us[] = { \
+    SQ2LV_KEY_CLASS_MODIFIER, SQ2LV_KEY_CLASS_MODIFIER, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0 \
+};
+
 static const int num_scancodes_actions_terminal_us = 5;
 
 static const int scancodes_actions_terminal_us[] = { \
@@ -338,6 +378,7 @@ static const sq2lv_layer_t layers_terminal_us[] = {
         .num_switchers = num_switchers_lower_terminal_us,
         .switcher_idxs = switcher_idxs_lower_terminal_us,
         .switcher_dests = switcher_dests_lower_terminal_us,
+        .key_classes = key_classes_lower_terminal_us,
         .num_scancodes = num_scancodes_lower_terminal_us,
         .scancodes = scancodes_lower_terminal_us,
         .scancode_idxs = scancode_idxs_lower_terminal_us,
@@ -352,6 +393,7 @@ static const sq2lv_layer_t layers_terminal_us[] = {
         .num_switchers = num_switchers_upper_terminal_us,
         .switcher_idxs = switcher_idxs_upper_terminal_us,
         .switcher_dests = switcher_dests_upper_terminal_us,
+        .key_classes = key_classes_upper_terminal_us,
         .num_scancodes = num_scancodes_upper_terminal_us,
         .scancodes = scancodes_upper_terminal_us,
         .scancode_idxs = scancode_idxs_upper_terminal_us,
@@ -366,6 +408,7 @@ static const sq2lv_layer_t layers_terminal_us[] = {
         .num_switchers = num_switchers_numbers_terminal_us,
         .switcher_idxs = switcher_idxs_numbers_terminal_us,
         .switcher_dests = switcher_dests_numbers_terminal_us,
+        .key_classes = key_classes_numbers_terminal_us,
         .num_scancodes = num_scancodes_numbers_terminal_us,
         .scancodes = scancodes_numbers_terminal_us,
         .scancode_idxs = scancode_idxs_numbers_terminal_us,
@@ -380,6 +423,7 @@ static const sq2lv_layer_t layers_terminal_us[] = {
         .num_switchers = num_switchers_symbols_terminal_us,
         .switcher_idxs = switcher_idxs_symbols_terminal_us,
         .switcher_dests = switcher_dests_symbols_terminal_us,
+        .key_classes = key_classes_symbols_terminal_us,
         .num_scancodes = num_scancodes_symbols_terminal_us,
         .scancodes = scancodes_symbols_terminal_us,
         .scancode_idxs = scancode_idxs_symbols_terminal_us,
@@ -394,6 +438,7 @@ static const sq2lv_layer_t layers_terminal_us[] = {
         .num_switchers = num_switchers_actions_terminal_us,
         .switcher_idxs = switcher_idxs_actions_terminal_us,
         .switcher_dests = switcher_dests_actions_terminal_us,
+        .key_classes = key_classes_actions_terminal_us,
         .num_scancodes = num_scancodes_actions_terminal_us,
         .scancodes = scancodes_actions_terminal_us,
         .scancode_idxs = scancode_idxs_actions_terminal_us,
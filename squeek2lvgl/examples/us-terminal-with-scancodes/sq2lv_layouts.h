@@ -38,6 +38,8 @@ typedef struct {
     const int * const switcher_idxs;
     /* Indexes of layers to jump to when triggering layer switch buttons */
     const int * const switcher_dests;
+    /* Class of each key by button index (SQ2LV_KEY_CLASS_* flags | destination layer index) */
+    const uint8_t * const key_classes;
     /* Total number of scancodes */
     const int num_scancodes;
     /* Flat array of scancodes */
@@ -45,6 +45,13 @@ static const int switcher_dests_lower_us[] = { \
     1, 2 \
 };
 
+static const uint8_t key_classes_lower_us[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 1, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Uppercase letters - generated from upper */
 
 static const int num_keys_upper_us = 34;
@@ -77,6 +84,13 @@ static const int switcher_dests_upper_us[] = { \
     0, 2 \
 };
 
+static const uint8_t key_classes_upper_us[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Numbers / symbols - generated from numbers */
 
 static const int num_keys_numbers_us = 35;
@@ -109,6 +123,13 @@ static const int switcher_dests_numbers_us[] = { \
     3, 0 \
 };
 
+static const uint8_t key_classes_numbers_us[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 3, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Symbols - generated from symbols */
 
 static const int num_keys_symbols_us = 35;
@@ -141,6 +162,13 @@ static const int switcher_dests_symbols_us[] = { \
     2, 0 \
 };
 
+static const uint8_t key_classes_symbols_us[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer array */
 
 static const int num_layers_us = 4;
@@ -154,7 +182,8 @@ static const sq2lv_layer_t layers_us[] = {
         .modifier_idxs = modifier_idxs_lower_us,
         .num_switchers = num_switchers_lower_us,
         .switcher_idxs = switcher_idxs_lower_us,
-        .switcher_dests = switcher_dests_lower_us
+        .switcher_dests = switcher_dests_lower_us,
+        .key_classes = key_classes_lower_us
     },
     {
         .num_keys = num_keys_upper_us,
@@ -164,7 +193,8 @@ static const sq2lv_layer_t layers_us[] = {
         .modifier_idxs = modifier_idxs_upper_us,
         .num_switchers = num_switchers_upper_us,
         .switcher_idxs = switcher_idxs_upper_us,
-        .switcher_dests = switcher_dests_upper_us
+        .switcher_dests = switcher_dests_upper_us,
+        .key_classes = key_classes_upper_us
     },
     {
         .num_keys = num_keys_numbers_us,
@@ -174,7 +204,8 @@ static const sq2lv_layer_t layers_us[] = {
         .modifier_idxs = modifier_idxs_numbers_us,
         .num_switchers = num_switchers_numbers_us,
         .switcher_idxs = switcher_idxs_numbers_us,
-        .switcher_dests = switcher_dests_numbers_us
+        .switcher_dests = switcher_dests_numbers_us,
+        .key_classes = key_classes_numbers_us
     },
     {
         .num_keys = num_keys_symbols_us,
@@ -184,7 +215,8 @@ static const sq2lv_layer_t layers_us[] = {
         .modifier_idxs = modifier_idxs_symbols_us,
         .num_switchers = num_switchers_symbols_us,
         .switcher_idxs = switcher_idxs_symbols_us,
-        .switcher_dests = switcher_dests_symbols_us
+        .switcher_dests = switcher_dests_symbols_us,
+        .key_classes = key_classes_symbols_us
     }
 };
 
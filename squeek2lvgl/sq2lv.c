@@ -6,14 +6,74 @@
 
 #include "sq2lv.h"
 
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/**
+ * Defines
+ */
+
+#define FILE_MAGIC "SQ2L"
+#define FILE_VERSION 1
+#define FILE_FLAG_SCANCODES 0x1
+
+#define MAX_LOADED_LAYOUTS 16
+#define MAX_LAYERS 8
 
 
 /**
  * Static variables
  */
 
-static sq2lv_layout_id_t current_layout_id = SQ2LV_LAYOUT_NONE;
+/* Header of a binary layout file. Integers are little-endian and offsets are relative to the start of the file. */
+struct file_header {
+    char magic[4];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t size;
+    uint32_t name;
+    uint32_t short_name;
+    uint32_t num_layers;
+    uint32_t layers;
+};
+
+/* Layer record in a binary layout file */
+struct file_layer {
+    uint32_t num_keys;
+    uint32_t num_keycaps;    /* Including row separators and the terminating empty string */
+    uint32_t keycaps;        /* uint32_t string offsets */
+    uint32_t attributes;     /* uint32_t LVGL button matrix control bits */
+    uint32_t num_modifiers;
+    uint32_t modifier_idxs;  /* int32_t */
+    uint32_t num_switchers;
+    uint32_t switcher_idxs;  /* int32_t */
+    uint32_t switcher_dests; /* int32_t */
+    uint32_t key_classes;    /* uint8_t */
+    uint32_t num_scancodes;
+    uint32_t scancodes;      /* int32_t */
+    uint32_t scancode_idxs;  /* int32_t */
+    uint32_t scancode_nums;  /* int32_t */
+};
+
+/* Layout that was loaded from a file */
+struct loaded_layout {
+    char *path;
+    const sq2lv_layout_t *layout;
+};
+
+static struct loaded_layout loaded_layouts[MAX_LOADED_LAYOUTS];
+static int num_loaded_layouts = 0;
+
+static const sq2lv_layout_t *current_layout = NULL;
+
+static uint8_t applied_layers = 0; /* Bit mask of layers whose maps were set on the keyboard */
 
 
 /**
@@ -45,13 +105,93 @@ static int keyboard_mode_to_layer_index(lv_keyboard_mode_t keyboard_mode);
 static int get_layer_index(lv_obj_t *keyboard);
 
 /**
- * Get the index of the destination layer for a layer switcher key in the current layout.
+ * Get a pointer to an array in a mapped layout file after checking that it lies within the file.
+ *
+ * @param data start of the file
+ * @param size size of the file
+ * @param offset offset of the array
+ * @param count number of elements
+ * @param element_size size of a single element
+ * @param ok pointer to a flag that is cleared if the array is out of bounds or misaligned
+ * @return pointer to the array or NULL if it is empty or invalid
+ */
+static const void *get_file_array(const uint8_t *data, size_t size, uint32_t offset, uint32_t count,
+    size_t element_size, bool *ok);
+
+/**
+ * Get a pointer to a string in a mapped layout file after checking that it is terminated within the file.
+ *
+ * @param data start of the file
+ * @param size size of the file
+ * @param offset offset of the string
+ * @param ok pointer to a flag that is cleared if the string is invalid
+ * @return pointer to the string or NULL if it is invalid
+ */
+static const char *get_file_string(const uint8_t *data, size_t size, uint32_t offset, bool *ok);
+
+/**
+ * Check that all values in an index array lie below a limit.
+ *
+ * @param idxs index array
+ * @param count number of indexes
+ * @param limit exclusive upper limit
+ * @return true if all indexes are valid, false otherwise
+ */
+static bool are_indexes_valid(const int32_t *idxs, uint32_t count, uint32_t limit);
+
+/**
+ * Set up a layer from its record in a mapped layout file. Key caps and control bits are referenced in place
+ * wherever LVGL's types allow it.
+ *
+ * @param data start of the file
+ * @param size size of the file
+ * @param record layer record
+ * @param layer pointer to the layer to set up
+ * @return true on success, false if the record is invalid
+ */
+static bool load_layer(const uint8_t *data, size_t size, const struct file_layer *record, sq2lv_layer_t *layer);
+
+/**
+ * Free the memory allocated for layers loaded from a file.
+ *
+ * @param layers layers array
+ * @param num_layers number of layers that were set up
+ */
+static void free_layers(sq2lv_layer_t *layers, int num_layers);
+
+/**
+ * Set up a layout from a mapped layout file.
+ *
+ * @param data start of the file
+ * @param size size of the file
+ * @return pointer to the layout or NULL if the file is invalid
+ */
+static const sq2lv_layout_t *load_layout_from_data(const uint8_t *data, size_t size);
+
+/**
+ * Show a layer of the current layout, setting its map on the keyboard the first time it is used.
+ *
+ * @param keyboard keyboard widget
+ * @param layer_index index of the layer to show
+ */
+static void activate_layer(lv_obj_t *keyboard, int layer_index);
+
+/**
+ * Get the keyboard's current layer in the current layout.
+ *
+ * @param keyboard keyboard widget
+ * @return pointer to the layer or NULL if no layout was applied or the layer doesn't exist
+ */
+static const sq2lv_layer_t *get_current_layer(lv_obj_t *keyboard);
+
+/**
+ * Look up the class of a key in the current layer.
  *
  * @param keyboard keyboard widget
  * @param btn_id button index corresponding to the key
- * @return the destination layer's index or -1 if the key is not a layer switcher
+ * @return SQ2LV_KEY_CLASS_* flags or 0 if the key is neither a layer switcher nor a modifier
  */
-static int get_destination_layer_index_for_layer_switcher(lv_obj_t *keyboard, uint16_t btn_id);
+static uint8_t get_key_class(lv_obj_t *keyboard, uint16_t btn_id);
 
 
 /**
@@ -108,23 +248,218 @@ static int get_layer_index(lv_obj_t *keyboard) {
     return keyboard_mode_to_layer_index(lv_keyboard_get_mode(keyboard));
 }
 
-static int get_destination_layer_index_for_layer_switcher(lv_obj_t *keyboard, uint16_t btn_id) {
-    if (current_layout_id < 0 || current_layout_id >= sq2lv_num_layouts) {
-        return -1;
+static const void *get_file_array(const uint8_t *data, size_t size, uint32_t offset, uint32_t count,
+        size_t element_size, bool *ok) {
+    if (count == 0) {
+        return NULL;
     }
 
-    int layer_index = get_layer_index(keyboard);
-    if (layer_index < 0 || layer_index >= sq2lv_layouts[current_layout_id].num_layers) {
-        return -1;
+    if (offset % LV_MIN(element_size, sizeof(uint32_t)) != 0
+            || (uint64_t)offset + (uint64_t)count * element_size > size) {
+        *ok = false;
+        return NULL;
+    }
+
+    return data + offset;
+}
+
+static const char *get_file_string(const uint8_t *data, size_t size, uint32_t offset, bool *ok) {
+    if (offset >= size || !memchr(data + offset, '\0', size - offset)) {
+        *ok = false;
+        return NULL;
+    }
+    return (const char *)(data + offset);
+}
+
+static bool are_indexes_valid(const int32_t *idxs, uint32_t count, uint32_t limit) {
+    for (uint32_t i = 0; i < count; ++i) {
+        if (idxs[i] < 0 || (uint32_t)idxs[i] >= limit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool load_layer(const uint8_t *data, size_t size, const struct file_layer *record, sq2lv_layer_t *layer) {
+    bool ok = true;
+
+    const uint32_t *keycap_offsets = get_file_array(data, size, record->keycaps, record->num_keycaps, sizeof(uint32_t), &ok);
+    const uint32_t *attributes = get_file_array(data, size, record->attributes, record->num_keys, sizeof(uint32_t), &ok);
+    const int32_t *modifier_idxs = get_file_array(data, size, record->modifier_idxs, record->num_modifiers, sizeof(int32_t), &ok);
+    const int32_t *switcher_idxs = get_file_array(data, size, record->switcher_idxs, record->num_switchers, sizeof(int32_t), &ok);
+    const int32_t *switcher_dests = get_file_array(data, size, record->switcher_dests, record->num_switchers, sizeof(int32_t), &ok);
+    const uint8_t *key_classes = get_file_array(data, size, record->key_classes, record->num_keys, sizeof(uint8_t), &ok);
+#if SQ2LV_SCANCODES_ENABLED
+    const int32_t *scancodes = get_file_array(data, size, record->scancodes, record->num_scancodes, sizeof(int32_t), &ok);
+    const int32_t *scancode_idxs = get_file_array(data, size, record->scancode_idxs, record->num_keys, sizeof(int32_t), &ok);
+    const int32_t *scancode_nums = get_file_array(data, size, record->scancode_nums, record->num_keys, sizeof(int32_t), &ok);
+#endif
+
+    if (!ok || record->num_keys == 0 || record->num_keycaps == 0
+            || !are_indexes_valid(modifier_idxs, record->num_modifiers, record->num_keys)
+            || !are_indexes_valid(switcher_idxs, record->num_switchers, record->num_keys)
+            || !are_indexes_valid(switcher_dests, record->num_switchers, MAX_LAYERS)) {
+        return false;
+    }
+
+#if SQ2LV_SCANCODES_ENABLED
+    for (uint32_t i = 0; i < record->num_keys; ++i) {
+        if (scancode_nums[i] < 0 || (scancode_nums[i] > 0 && (scancode_idxs[i] < 0
+                || (uint64_t)scancode_idxs[i] + scancode_nums[i] > record->num_scancodes))) {
+            return false;
+        }
+    }
+#endif
+
+    /* LVGL needs an array of pointers but the strings themselves stay in the mapping */
+    const char **keycaps = malloc(record->num_keycaps * sizeof(const char *));
+    if (!keycaps) {
+        return false;
+    }
+
+    uint32_t num_keys = 0;
+    for (uint32_t i = 0; i < record->num_keycaps && ok; ++i) {
+        keycaps[i] = get_file_string(data, size, keycap_offsets[i], &ok);
+        if (ok && keycaps[i][0] != '\0' && strcmp(keycaps[i], "\n") != 0) {
+            ++num_keys;
+        }
+    }
+
+    if (!ok || num_keys != record->num_keys || keycaps[record->num_keycaps - 1][0] != '\0') {
+        free(keycaps);
+        return false;
+    }
+
+    /* Control bits are stored with 32 bits and only need to be copied if LVGL uses a different width */
+    const lv_buttonmatrix_ctrl_t *ctrl = (const lv_buttonmatrix_ctrl_t *)attributes;
+    if (sizeof(lv_buttonmatrix_ctrl_t) != sizeof(uint32_t)) {
+        lv_buttonmatrix_ctrl_t *converted = malloc(record->num_keys * sizeof(lv_buttonmatrix_ctrl_t));
+        if (!converted) {
+            free(keycaps);
+            return false;
+        }
+        for (uint32_t i = 0; i < record->num_keys; ++i) {
+            converted[i] = (lv_buttonmatrix_ctrl_t)attributes[i];
+        }
+        ctrl = converted;
+    }
+
+    const sq2lv_layer_t loaded = {
+        .num_keys = record->num_keys,
+        .keycaps = keycaps,
+        .attributes = ctrl,
+        .num_modifiers = record->num_modifiers,
+        .modifier_idxs = (const int *)modifier_idxs,
+        .num_switchers = record->num_switchers,
+        .switcher_idxs = (const int *)switcher_idxs,
+        .switcher_dests = (const int *)switcher_dests,
+        .key_classes = key_classes,
+#if SQ2LV_SCANCODES_ENABLED
+        .num_scancodes = record->num_scancodes,
+        .scancodes = (const int *)scancodes,
+        .scancode_idxs = (const int *)scancode_idxs,
+        .scancode_nums = (const int *)scancode_nums
+#endif
+    };
+    memcpy(layer, &loaded, sizeof(loaded));
+
+    return true;
+}
+
+static void free_layers(sq2lv_layer_t *layers, int num_layers) {
+    for (int i = 0; i < num_layers; ++i) {
+        free((void *)layers[i].keycaps);
+        if (sizeof(lv_buttonmatrix_ctrl_t) != sizeof(uint32_t)) {
+            free((void *)layers[i].attributes);
+        }
+    }
+    free(layers);
+}
+
+static const sq2lv_layout_t *load_layout_from_data(const uint8_t *data, size_t size) {
+    const struct file_header *header = (const struct file_header *)data;
+    if (memcmp(header->magic, FILE_MAGIC, sizeof(header->magic)) != 0 || header->version != FILE_VERSION
+            || header->size != size || header->num_layers == 0 || header->num_layers > MAX_LAYERS) {
+        return NULL;
+    }
+
+#if SQ2LV_SCANCODES_ENABLED
+    if (!(header->flags & FILE_FLAG_SCANCODES)) {
+        return NULL;
+    }
+#endif
+
+    bool ok = true;
+    const char *name = get_file_string(data, size, header->name, &ok);
+    const char *short_name = get_file_string(data, size, header->short_name, &ok);
+    const struct file_layer *records = get_file_array(data, size, header->layers, header->num_layers,
+        sizeof(struct file_layer), &ok);
+    if (!ok) {
+        return NULL;
+    }
+
+    sq2lv_layer_t *layers = calloc(header->num_layers, sizeof(sq2lv_layer_t));
+    if (!layers) {
+        return NULL;
     }
 
-    for (int i = 0; i < sq2lv_layouts[current_layout_id].layers[layer_index].num_switchers; ++i) {
-        if (sq2lv_layouts[current_layout_id].layers[layer_index].switcher_idxs[i] == btn_id) {
-            return sq2lv_layouts[current_layout_id].layers[layer_index].switcher_dests[i];
+    for (uint32_t i = 0; i < header->num_layers; ++i) {
+        if (!load_layer(data, size, &records[i], &layers[i])) {
+            free_layers(layers, i);
+            return NULL;
         }
     }
 
-    return -1;
+    sq2lv_layout_t *layout = malloc(sizeof(sq2lv_layout_t));
+    if (!layout) {
+        free_layers(layers, header->num_layers);
+        return NULL;
+    }
+
+    const sq2lv_layout_t loaded = {
+        .name = name,
+        .short_name = short_name,
+        .num_layers = header->num_layers,
+        .layers = layers
+    };
+    memcpy(layout, &loaded, sizeof(loaded));
+
+    return layout;
+}
+
+static void activate_layer(lv_obj_t *keyboard, int layer_index) {
+    lv_keyboard_mode_t mode = layer_index_to_keyboard_mode(layer_index);
+
+    if (!(applied_layers & (1 << layer_index))) {
+        const sq2lv_layer_t *layer = &(current_layout->layers[layer_index]);
+        lv_keyboard_set_map(keyboard, mode, (const char **)layer->keycaps, layer->attributes);
+        applied_layers |= 1 << layer_index;
+    }
+
+    if (mode != lv_keyboard_get_mode(keyboard)) {
+        lv_keyboard_set_mode(keyboard, mode);
+    }
+}
+
+static const sq2lv_layer_t *get_current_layer(lv_obj_t *keyboard) {
+    if (!current_layout) {
+        return NULL;
+    }
+
+    int layer_index = get_layer_index(keyboard);
+    if (layer_index < 0 || layer_index >= current_layout->num_layers) {
+        return NULL;
+    }
+
+    return &(current_layout->layers[layer_index]);
+}
+
+static uint8_t get_key_class(lv_obj_t *keyboard, uint16_t btn_id) {
+    const sq2lv_layer_t *layer = get_current_layer(keyboard);
+    if (!layer || btn_id >= layer->num_keys) {
+        return 0;
+    }
+    return layer->key_classes[btn_id];
 }
 
 
@@ -132,9 +467,72 @@ static int get_destination_layer_index_for_layer_switcher(lv_obj_t *keyboard, ui
  * Public functions
  */
 
+sq2lv_layout_id_t sq2lv_load_layout(const char *path) {
+    for (int i = 0; i < num_loaded_layouts; ++i) {
+        if (strcmp(loaded_layouts[i].path, path) == 0) {
+            return sq2lv_num_layouts + i;
+        }
+    }
+
+    if (num_loaded_layouts >= MAX_LOADED_LAYOUTS) {
+        LV_LOG_WARN("Cannot load layout file %s because the maximum of %d layout files was reached", path, MAX_LOADED_LAYOUTS);
+        return SQ2LV_LAYOUT_NONE;
+    }
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LV_LOG_WARN("Could not open layout file %s", path);
+        return SQ2LV_LAYOUT_NONE;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(struct file_header)) {
+        LV_LOG_WARN("Could not load layout file %s because it is too small", path);
+        close(fd);
+        return SQ2LV_LAYOUT_NONE;
+    }
+
+    /* Map the file so that only the pages of the layers actually in use are read in */
+    size_t size = st.st_size;
+    const uint8_t *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        LV_LOG_WARN("Could not map layout file %s", path);
+        return SQ2LV_LAYOUT_NONE;
+    }
+
+    char *path_copy = strdup(path);
+    const sq2lv_layout_t *layout = path_copy ? load_layout_from_data(data, size) : NULL;
+    if (!layout) {
+        LV_LOG_WARN("Could not load invalid layout file %s", path);
+        free(path_copy);
+        munmap((void *)data, size);
+        return SQ2LV_LAYOUT_NONE;
+    }
+
+    /* The mapping stays alive for as long as the process runs */
+    loaded_layouts[num_loaded_layouts].path = path_copy;
+    loaded_layouts[num_loaded_layouts].layout = layout;
+    return sq2lv_num_layouts + num_loaded_layouts++;
+}
+
+int sq2lv_get_num_layouts(void) {
+    return sq2lv_num_layouts + num_loaded_layouts;
+}
+
+const sq2lv_layout_t *sq2lv_get_layout(sq2lv_layout_id_t layout_id) {
+    if (layout_id >= 0 && layout_id < sq2lv_num_layouts) {
+        return &(sq2lv_layouts[layout_id]);
+    }
+    if (layout_id >= sq2lv_num_layouts && layout_id < sq2lv_get_num_layouts()) {
+        return loaded_layouts[layout_id - sq2lv_num_layouts].layout;
+    }
+    return NULL;
+}
+
 sq2lv_layout_id_t sq2lv_find_layout_with_short_name(const char *name) {
-    for (int i = 0; i < sq2lv_num_layouts; ++i) {
-        if (strcmp(sq2lv_layouts[i].short_name, name) == 0) {
+    for (int i = 0; i < sq2lv_get_num_layouts(); ++i) {
+        if (strcmp(sq2lv_get_layout(i)->short_name, name) == 0) {
             return i;
         }
     }
@@ -142,103 +540,71 @@ sq2lv_layout_id_t sq2lv_find_layout_with_short_name(const char *name) {
 }
 
 void sq2lv_switch_layout(lv_obj_t *keyboard, sq2lv_layout_id_t layout_id) {
-    if (layout_id < 0 || layout_id >= sq2lv_num_layouts) {
+    const sq2lv_layout_t *layout = sq2lv_get_layout(layout_id);
+    if (!layout) {
         return;
     }
 
-    /* Assign layers */
-    for (int i = 0; i < sq2lv_layouts[layout_id].num_layers; ++i) {
-        lv_keyboard_set_map(keyboard, layer_index_to_keyboard_mode(i),
-            (const char **)sq2lv_layouts[layout_id].layers[i].keycaps,
-            sq2lv_layouts[layout_id].layers[i].attributes);
-    }
+    current_layout = layout;
+    applied_layers = 0;
 
     /* Switch to default layer if current layer doesn't exist in new layout */
     int layer_index = get_layer_index(keyboard);
-    if (layer_index < 0 || layer_index >= sq2lv_layouts[layout_id].num_layers) {
-        lv_keyboard_set_mode(keyboard, layer_index_to_keyboard_mode(0));
+    if (layer_index < 0 || layer_index >= layout->num_layers) {
+        layer_index = 0;
     }
 
-    current_layout_id = layout_id;
+    /* Only assign the current layer, the others are assigned when they're first switched to */
+    activate_layer(keyboard, layer_index);
 }
 
 bool sq2lv_is_layer_switcher(lv_obj_t *keyboard, uint16_t btn_id) {
-    return get_destination_layer_index_for_layer_switcher(keyboard, btn_id) >= 0;
+    return (get_key_class(keyboard, btn_id) & SQ2LV_KEY_CLASS_SWITCHER) != 0;
 }
 
 bool sq2lv_switch_layer(lv_obj_t *keyboard, uint16_t btn_id) {
-    int destination_layer_index = get_destination_layer_index_for_layer_switcher(keyboard, btn_id);
-    if (destination_layer_index < 0 || destination_layer_index >= sq2lv_layouts[current_layout_id].num_layers) {
+    uint8_t key_class = get_key_class(keyboard, btn_id);
+    if (!(key_class & SQ2LV_KEY_CLASS_SWITCHER)) {
         return false;
     }
 
-    lv_keyboard_set_mode(keyboard, layer_index_to_keyboard_mode(destination_layer_index));
-    return true;
-}
-
-bool sq2lv_is_modifier(lv_obj_t *keyboard, uint16_t btn_id) {
-    if (current_layout_id < 0 || current_layout_id >= sq2lv_num_layouts) {
+    int destination_layer_index = key_class & SQ2LV_KEY_CLASS_DEST_MASK;
+    if (destination_layer_index >= current_layout->num_layers) {
         return false;
     }
 
-    int layer_index = get_layer_index(keyboard);
-    if (layer_index < 0 || layer_index >= sq2lv_layouts[current_layout_id].num_layers) {
-        return false;
-    }
-
-    for (int i = 0; i < sq2lv_layouts[current_layout_id].layers[layer_index].num_modifiers; ++i) {
-        if (sq2lv_layouts[current_layout_id].layers[layer_index].modifier_idxs[i] == btn_id) {
-            return true;
-        }
-    }
+    activate_layer(keyboard, destination_layer_index);
+    return true;
+}
 
-    return false;
+bool sq2lv_is_modifier(lv_obj_t *keyboard, uint16_t btn_id) {
+    return (get_key_class(keyboard, btn_id) & SQ2LV_KEY_CLASS_MODIFIER) != 0;
 }
 
 int *sq2lv_get_modifier_indexes(lv_obj_t *keyboard, int *num_modifiers) {
-    if (current_layout_id < 0 || current_layout_id >= sq2lv_num_layouts) {
+    const sq2lv_layer_t *layer = get_current_layer(keyboard);
+    if (!layer || layer->num_modifiers == 0) {
         *num_modifiers = 0;
         return NULL;
     }
 
-    int layer_index = get_layer_index(keyboard);
-    if (layer_index < 0 || layer_index >= sq2lv_layouts[current_layout_id].num_layers) {
-        *num_modifiers = 0;
-        return NULL;
-    }
-
-    *num_modifiers = sq2lv_layouts[current_layout_id].layers[layer_index].num_modifiers;
-    if (*num_modifiers == 0) {
-        return NULL;
-    }
-
-    return (int *)(&(sq2lv_layouts[current_layout_id].layers[layer_index].modifier_idxs[0]));
+    *num_modifiers = layer->num_modifiers;
+    return (int *)(&(layer->modifier_idxs[0]));
 }
 
 #if SQ2LV_SCANCODES_ENABLED
 const int * const sq2lv_get_scancodes(lv_obj_t *keyboard, uint16_t btn_id, int *num_scancodes) {
-    if (current_layout_id < 0 || current_layout_id >= sq2lv_num_layouts) {
-        *num_scancodes = 0;
-        return NULL;
-    }
-
-    int layer_index = get_layer_index(keyboard);
-    if (layer_index < 0 || layer_index >= sq2lv_layouts[current_layout_id].num_layers) {
-        *num_scancodes = 0;
-        return NULL;
-    }
-
-    if (btn_id >= sq2lv_layouts[current_layout_id].layers[layer_index].num_keys) {
+    const sq2lv_layer_t *layer = get_current_layer(keyboard);
+    if (!layer || btn_id >= layer->num_keys) {
         *num_scancodes = 0;
         return NULL;
     }
 
-    *num_scancodes = sq2lv_layouts[current_layout_id].layers[layer_index].scancode_nums[btn_id];
+    *num_scancodes = layer->scancode_nums[btn_id];
     if (*num_scancodes == 0) {
         return NULL;
     }
 
-    const int index = sq2lv_layouts[current_layout_id].layers[layer_index].scancode_idxs[btn_id];
-    return &(sq2lv_layouts[current_layout_id].layers[layer_index].scancodes[index]);
+    return &(layer->scancodes[layer->scancode_idxs[btn_id]]);
 }
 #endif /* SQ2LV_SCANCODES_ENABLED */
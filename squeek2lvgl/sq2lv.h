@@ -14,6 +14,36 @@
 #define SQ2LV_CTRL_MOD_ACTIVE   (LV_BUTTONMATRIX_CTRL_CLICK_TRIG | LV_BUTTONMATRIX_CTRL_CHECKABLE)
 #define SQ2LV_CTRL_MOD_INACTIVE (LV_BUTTONMATRIX_CTRL_CLICK_TRIG | LV_BUTTONMATRIX_CTRL_CHECKABLE | LV_BUTTONMATRIX_CTRL_CHECKED)
 
+/* Key classes (the lower bits of a switcher's class hold the destination layer index) */
+#define SQ2LV_KEY_CLASS_SWITCHER   0x80
+#define SQ2LV_KEY_CLASS_MODIFIER   0x40
+#define SQ2LV_KEY_CLASS_DEST_MASK  0x07
+
+/**
+ * Load a binary layout file written by squeek2lvgl.py --binary. The file is mapped into memory and used in place.
+ * Loading the same path repeatedly returns the same ID.
+ *
+ * @param path path of the layout file
+ * @return ID of the loaded layout or SQ2LV_LAYOUT_NONE if the file could not be loaded
+ */
+sq2lv_layout_id_t sq2lv_load_layout(const char *path);
+
+/**
+ * Get the total number of layouts including the ones loaded at runtime. Loaded layouts use the IDs
+ * from sq2lv_num_layouts onwards.
+ *
+ * @return number of layouts
+ */
+int sq2lv_get_num_layouts(void);
+
+/**
+ * Get a layout by its ID.
+ *
+ * @param layout_id layout ID
+ * @return pointer to the layout or NULL if the ID is invalid
+ */
+const sq2lv_layout_t *sq2lv_get_layout(sq2lv_layout_id_t layout_id);
+
 /**
  * Find the first layout with a given short name.
  *
@@ -23,7 +53,8 @@
 sq2lv_layout_id_t sq2lv_find_layout_with_short_name(const char *name);
 
 /**
- * Apply a layout to a keyboard.
+ * Apply a layout to a keyboard. Only the current layer's map is set right away. The maps of other layers are set
+ * when sq2lv_switch_layer first switches to them, so the keyboard's mode should only be changed through sq2lv.
  *
  * @param keyboard keyboard widget
  * @param layout_id layout ID
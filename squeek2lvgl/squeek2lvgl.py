@@ -5,9 +5,12 @@
 
 
 import argparse
+import codecs
 from typing import Set
 import git
 import os
+import re
+import struct
 import sys
 import tempfile
 import yaml
@@ -22,6 +25,16 @@ outfile_h = 'sq2lv_layouts.h'
 repository_url = 'https://gitlab.gnome.org/World/Phosh/squeekboard.git'
 rel_layouts_dir = 'data/keyboards'
 
+input_event_codes_h = '/usr/include/linux/input-event-codes.h'
+
+lvgl_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'lvgl')
+lv_buttonmatrix_h = os.path.join(lvgl_dir, 'src', 'widgets', 'buttonmatrix', 'lv_buttonmatrix.h')
+lv_symbol_def_h = os.path.join(lvgl_dir, 'src', 'font', 'lv_symbol_def.h')
+
+binary_magic = b'SQ2L'
+binary_version = 1
+binary_flag_scancodes = 0x1
+
 
 ###
 # General helpers
@@ -63,6 +76,8 @@ def parse_arguments():
                         help='insert left / right arrow before / after space key')
     parser.add_argument('--generate-scancodes', action='store_true', dest='generate_scancodes', help='also '
                         + 'generate scancode tables (only works for US layout currently)')
+    parser.add_argument('--binary', action='store_true', dest='binary', help='also write a binary layout file '
+                        + 'per layout that can be loaded at runtime with sq2lv_load_layout')
     parser.add_argument('--output', dest='output', type=str, required=True, help='output directory for generated '
                         + 'files')
     args = parser.parse_args()
@@ -116,6 +131,54 @@ def write_files(lines_c, lines_h):
         fp.write('\n'.join(lines_h))
 
 
+def load_input_event_codes():
+    """Return a dictionary mapping KEY_* constants to their values as defined by the kernel headers.
+    """
+    if not os.path.isfile(input_event_codes_h):
+        die(f'could not find {input_event_codes_h} for resolving scancodes')
+
+    codes = {}
+    with open(input_event_codes_h, 'r') as fp:
+        for line in fp:
+            match = re.match(r'#define\s+(KEY_\w+)\s+(\w+)', line)
+            if not match:
+                continue
+            value = match.group(2)
+            codes[match.group(1)] = codes[value] if value in codes else int(value, 0)
+    return codes
+
+
+def load_buttonmatrix_ctrls():
+    """Return a dictionary mapping LV_BUTTONMATRIX_CTRL_* constants to their values as defined by LVGL's headers.
+    """
+    if not os.path.isfile(lv_buttonmatrix_h):
+        die(f'could not find {lv_buttonmatrix_h} for resolving button attributes')
+
+    ctrls = {}
+    with open(lv_buttonmatrix_h, 'r') as fp:
+        for line in fp:
+            # Matches both enumerators and defines, e.g. "LV_BUTTONMATRIX_CTRL_HIDDEN = 0x0010," or "(1 << 4)"
+            match = re.match(r'\s*(?:#define\s+)?(LV_BUTTONMATRIX_CTRL_\w+)\s*=?\s*([0-9a-fA-Fx()<\s]+?)\s*(,|/|$)', line)
+            if match:
+                ctrls[match.group(1)] = eval(match.group(2), {'__builtins__': {}})
+    if not ctrls:
+        die(f'could not find any button attributes in {lv_buttonmatrix_h}')
+    return ctrls
+
+
+def load_lvgl_symbols():
+    """Return a dictionary mapping LV_SYMBOL_* constants to their UTF-8 encoded values as defined by LVGL's headers.
+    """
+    if not os.path.isfile(lv_symbol_def_h):
+        die(f'could not find {lv_symbol_def_h} for resolving symbols')
+
+    symbols = {}
+    with open(lv_symbol_def_h, 'r') as fp:
+        for match in re.finditer(r'#define\s+(LV_SYMBOL_\w+)\s+"([^"]*)"', fp.read()):
+            symbols[match.group(1)] = codecs.escape_decode(match.group(2).encode('utf-8'))[0]
+    return symbols
+
+
 def comma_if_needed(sequence, idx):
     """Return a comma unless idx points to the last element in sequence.
     
@@ -248,6 +311,182 @@ class SourceFileBuilder(object):
         return self.add_array(static, type, identifier, [values], '', array_terminator)
 
 
+###
+# BinaryLayoutBuilder
+##
+
+# Values of squeek2lvgl's own constants that appear in generated attributes and key classes, needs to be kept in
+# sync with sq2lv.h. LVGL's constants are read from its headers with load_buttonmatrix_ctrls and load_lvgl_symbols.
+sq2lv_constants = {
+    'SQ2LV_KEY_CLASS_SWITCHER': 0x80,
+    'SQ2LV_KEY_CLASS_MODIFIER': 0x40
+}
+sq2lv_compound_constants = {
+    'SQ2LV_CTRL_NON_CHAR': 'LV_BUTTONMATRIX_CTRL_CLICK_TRIG | LV_BUTTONMATRIX_CTRL_CHECKED',
+    'SQ2LV_CTRL_MOD_ACTIVE': 'LV_BUTTONMATRIX_CTRL_CLICK_TRIG | LV_BUTTONMATRIX_CTRL_CHECKABLE',
+    'SQ2LV_CTRL_MOD_INACTIVE': 'LV_BUTTONMATRIX_CTRL_CLICK_TRIG | LV_BUTTONMATRIX_CTRL_CHECKABLE | LV_BUTTONMATRIX_CTRL_CHECKED'
+}
+
+
+def load_binary_constants():
+    """Return a dictionary mapping all C constants that can appear in generated attributes and key classes to their
+    values.
+    """
+    constants = dict(sq2lv_constants)
+    constants.update(load_buttonmatrix_ctrls())
+    for name, expression in sq2lv_compound_constants.items():
+        constants[name] = c_flags_to_int(constants, expression)
+    return constants
+
+
+def c_flags_to_int(constants, expression):
+    """Return the value of a C expression that ORs together numbers and known constants.
+
+    constants -- dictionary mapping known constants to their values
+    expression -- C expression
+    """
+    value = 0
+    for token in expression.split('|'):
+        token = token.strip()
+        if token in constants:
+            value |= constants[token]
+        elif re.fullmatch(r'(0x[0-9a-fA-F]+|[0-9]+)', token):
+            value |= int(token, 0)
+        else:
+            die(f'Cannot resolve {token} for binary layout')
+    return value
+
+
+def c_value_to_keycap(args, symbols, c_value):
+    """Return the UTF-8 encoded keycap for the right-hand side C value of a keycap.
+
+    args -- commandline arguments
+    symbols -- dictionary mapping LV_SYMBOL_* constants to their UTF-8 encoded values
+    c_value -- C value as returned by keycap_to_c_value
+    """
+    if c_value == 'SQ2LV_SYMBOL_SHIFT':
+        return (args.shift_keycap if args.shift_keycap else 'Shift').encode('utf-8')
+    if c_value in symbols:
+        return symbols[c_value]
+    if c_value.startswith('"') and c_value.endswith('"'):
+        return re.sub(r'\\(.)', r'\1', c_value[1:-1]).encode('utf-8')
+    die(f'Cannot convert keycap {c_value} for binary layout')
+
+
+class BinaryLayoutBuilder(object):
+    """Builder for binary layout files. Keep in sync with the reader in sq2lv.c.
+    """
+
+    header_format = '<4s7I'
+    layer_format = '<14I'
+
+    def __init__(self, name, short_name, has_scancodes):
+        """Constructor.
+
+        name -- layout name
+        short_name -- layout short name
+        has_scancodes -- whether layers include scancodes
+        """
+        self.name = name
+        self.short_name = short_name
+        self.has_scancodes = has_scancodes
+        self.layers = []
+
+    def add_layer(self, keycaps, attrs, modifier_idxs, switcher_idxs, switcher_dests, key_classes, scancodes):
+        """Add a layer and return the builder.
+
+        keycaps -- list (rows) of lists (keys) of UTF-8 encoded keycaps
+        attrs -- list (rows) of lists (keys) of LVGL button attributes
+        modifier_idxs -- button indexes of modifier keys
+        switcher_idxs -- button indexes of layer switching keys
+        switcher_dests -- destination layer indexes of layer switching keys
+        key_classes -- list (rows) of lists (keys) of key classes
+        scancodes -- list (rows) of lists (keys) of lists of scancodes
+        """
+        flat_keycaps = []
+        for i, keycaps_in_row in enumerate(keycaps):
+            flat_keycaps += keycaps_in_row
+            flat_keycaps.append(b'\n' if i < len(keycaps) - 1 else b'')
+
+        self.layers.append({
+            'num_keys': sum([len(row) for row in keycaps]),
+            'keycaps': flat_keycaps,
+            'attributes': [a for row in attrs for a in row],
+            'modifier_idxs': modifier_idxs,
+            'switcher_idxs': switcher_idxs,
+            'switcher_dests': switcher_dests,
+            'key_classes': [c for row in key_classes for c in row],
+            'scancodes': [codes for row in scancodes for codes in row]
+        })
+        return self
+
+    def write(self, path):
+        """Write the layout to a file.
+
+        path -- output file path
+        """
+        data = bytearray()
+        data += bytes(struct.calcsize(self.header_format) + len(self.layers) * struct.calcsize(self.layer_format))
+
+        strings = {}
+        def add_string(value):
+            if value not in strings:
+                strings[value] = len(data)
+                data.extend(value + b'\0')
+            return strings[value]
+
+        def add_array(format, values):
+            if not values:
+                return 0
+            data.extend(bytes(-len(data) % 4))
+            offset = len(data)
+            data.extend(struct.pack(f'<{len(values)}{format}', *values))
+            return offset
+
+        name = add_string(self.name.encode('utf-8'))
+        short_name = add_string(self.short_name.encode('utf-8'))
+
+        records = []
+        for layer in self.layers:
+            keycap_offsets = [add_string(k) for k in layer['keycaps']]
+
+            scancodes = []
+            scancode_idxs = []
+            scancode_nums = []
+            for codes in layer['scancodes']:
+                scancode_idxs.append(len(scancodes) if codes else -1)
+                scancode_nums.append(len(codes))
+                scancodes += codes
+
+            records.append((
+                layer['num_keys'],
+                len(keycap_offsets),
+                add_array('I', keycap_offsets),
+                add_array('I', layer['attributes']),
+                len(layer['modifier_idxs']),
+                add_array('i', layer['modifier_idxs']),
+                len(layer['switcher_idxs']),
+                add_array('i', layer['switcher_idxs']),
+                add_array('i', layer['switcher_dests']),
+                add_array('B', layer['key_classes']),
+                len(scancodes),
+                add_array('i', scancodes),
+                add_array('i', scancode_idxs if self.has_scancodes else []),
+                add_array('i', scancode_nums if self.has_scancodes else [])
+            ))
+
+        flags = binary_flag_scancodes if self.has_scancodes else 0
+        offset = struct.calcsize(self.header_format)
+        struct.pack_into(self.header_format, data, 0, binary_magic, binary_version, flags, len(data), name,
+                         short_name, len(records), offset)
+        for record in records:
+            struct.pack_into(self.layer_format, data, offset, *record)
+            offset += struct.calcsize(self.layer_format)
+
+        with open(path, 'wb') as fp:
+            fp.write(data)
+
+
 ###
 # Layout processing
 ##
@@ -671,6 +910,35 @@ def get_keycaps_attrs_modifiers_switchers_scancodes(args, view_id, data_views, d
     return keycaps, attrs, modifier_idxs, switcher_idxs, switcher_dests, scancodes
 
 
+def get_key_classes(keycaps, modifier_idxs, switcher_idxs, switcher_dests):
+    """Return a list (rows) of lists (keys) of C expressions that classify each key of a layer, suitable
+    for looking up a key's class by its button index.
+
+    keycaps -- list (rows) of list (keys) of keycaps
+    modifier_idxs -- button indexes of modifier keys
+    switcher_idxs -- button indexes of layer switching keys
+    switcher_dests -- destination layer indexes of layer switching keys
+    """
+    classes = []
+    idx = 0
+
+    for keycaps_in_row in keycaps:
+        classes_in_row = []
+
+        for _ in keycaps_in_row:
+            flags = []
+            if idx in switcher_idxs:
+                flags += ['SQ2LV_KEY_CLASS_SWITCHER', str(switcher_dests[switcher_idxs.index(idx)])]
+            if idx in modifier_idxs:
+                flags.append('SQ2LV_KEY_CLASS_MODIFIER')
+            classes_in_row.append(' | '.join(flags) if flags else '0')
+            idx += 1
+
+        classes.append(classes_in_row)
+
+    return classes
+
+
 def flatten_scancodes(scancodes):
     """Process a nested list of scancodes per row and key and return a flattened list of scancodes per row,
     a list of starting indexes and a list of scancode counts.
@@ -729,6 +997,9 @@ if __name__ == '__main__':
 
     layouts = []
     unique_scancodes = {}
+    input_event_codes = load_input_event_codes() if args.binary and args.generate_scancodes else {}
+    binary_constants = load_binary_constants() if args.binary else {}
+    binary_symbols = load_lvgl_symbols() if args.binary else {}
 
     with tempfile.TemporaryDirectory() as tmp:
         clone_squeekboard_repo(tmp)
@@ -750,6 +1021,7 @@ if __name__ == '__main__':
             c_builder.add_line()
 
             layer_identifiers = []
+            binary_builder = BinaryLayoutBuilder(layout_name, layout_id, args.generate_scancodes)
 
             view_ids = [view_id for view_id in data_views if view_id_to_layer_name(view_id) != None]
 
@@ -781,6 +1053,20 @@ if __name__ == '__main__':
                         die(f'Unhandled layer switch destination {dest}')
                 switcher_dests = [view_ids.index(d) for d in switcher_dests if d in view_ids]
 
+                if len(view_ids) > 8:
+                    die(f'Layout {layout_id} has more layers than fit into a key class')
+
+                # Needs to happen before the keycap rows are extended with terminators below
+                key_classes = get_key_classes(keycaps, modifier_idxs, switcher_idxs, switcher_dests)
+
+                if args.binary:
+                    binary_builder.add_layer(
+                        [[c_value_to_keycap(args, binary_symbols, k) for k in row] for row in keycaps],
+                        [[c_flags_to_int(binary_constants, a) for a in row] for row in attrs],
+                        modifier_idxs, switcher_idxs, switcher_dests,
+                        [[c_flags_to_int(binary_constants, c) for c in row] for row in key_classes],
+                        [[[input_event_codes[c] for c in codes] for codes in row] for row in scancodes])
+
                 c_builder.add_line(f'static const int num_keys_{layer_identifier} = {sum([len(row) for row in keycaps])};')
                 c_builder.add_line()
                 c_builder.add_array(True, 'const char * const', f'keycaps_{layer_identifier}', keycaps, '"\\n"', '""')
@@ -800,6 +1086,9 @@ if __name__ == '__main__':
                 c_builder.add_flat_array(True, 'const int', f'switcher_dests_{layer_identifier}', switcher_dests, '')
                 c_builder.add_line()
 
+                c_builder.add_array(True, 'const uint8_t', f'key_classes_{layer_identifier}', key_classes, '', '')
+                c_builder.add_line()
+
                 if args.generate_scancodes:
                     scancodes_flat, scancode_idxs, scancode_nums = flatten_scancodes(scancodes)
 
@@ -823,7 +1112,7 @@ if __name__ == '__main__':
             c_builder.add_line(f'static const sq2lv_layer_t layers_{layout_identifier}[] = ' + '{')
             for i, identifier in enumerate(layer_identifiers):
                 c_builder.add_line('    {')
-                fields = ['num_keys', 'keycaps', 'attributes', 'num_modifiers', 'modifier_idxs', 'num_switchers', 'switcher_idxs', 'switcher_dests']
+                fields = ['num_keys', 'keycaps', 'attributes', 'num_modifiers', 'modifier_idxs', 'num_switchers', 'switcher_idxs', 'switcher_dests', 'key_classes']
                 if args.generate_scancodes:
                     fields += ['num_scancodes', 'scancodes', 'scancode_idxs', 'scancode_nums']
                 for k, field in enumerate(fields):
@@ -832,6 +1121,9 @@ if __name__ == '__main__':
             c_builder.add_line('};')
             c_builder.add_line()
 
+            if args.binary:
+                binary_builder.write(os.path.join(args.output, f'{layout_identifier}.sq2lv'))
+
             layouts.append({
                 'name': layout_name,
                 'short_name': layout_id,
@@ -865,6 +1157,8 @@ if __name__ == '__main__':
     h_builder.add_line('    const int * const switcher_idxs;')
     h_builder.add_line('    /* Indexes of layers to jump to when triggering layer switch buttons */')
     h_builder.add_line('    const int * const switcher_dests;')
+    h_builder.add_line('    /* Class of each key by button index (SQ2LV_KEY_CLASS_* flags | destination layer index) */')
+    h_builder.add_line('    const uint8_t * const key_classes;')
     if args.generate_scancodes:
         h_builder.add_line('    /* Total number of scancodes */')
         h_builder.add_line('    const int num_scancodes;')
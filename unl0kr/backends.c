@@ -22,6 +22,7 @@ const char *ul_backends_backends[] = {
 #if LV_USE_LINUX_DRM
     "drm",
 #endif /* LV_USE_LINUX_DRM */
+    "memory",
     NULL
 };
 
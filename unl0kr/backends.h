@@ -22,6 +22,7 @@ typedef enum {
 #if LV_USE_LINUX_DRM
     UL_BACKENDS_BACKEND_DRM,
 #endif /* LV_USE_LINUX_DRM */
+    UL_BACKENDS_BACKEND_MEMORY,
 } ul_backends_backend_id_t;
 
 /**
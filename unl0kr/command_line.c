@@ -44,6 +44,9 @@ static void init_opts(ul_cli_opts *opts) {
     opts->x_offset = 0;
     opts->y_offset = 0;
     opts->dpi = 0;
+    opts->record_file = NULL;
+    opts->replay_file = NULL;
+    opts->replay_fast = false;
     opts->verbose = false;
 }
 
@@ -66,6 +69,11 @@ static void print_usage() {
         "                            vertical pixels, offset horizontally by X\n"
         "                            pixels and vertically by Y pixels\n"
         "  -d  --dpi=N               Override the display's DPI value\n"
+        "  -R, --record=PATH         Record input events into a trace file\n"
+        "  -p, --replay=PATH         Replay input events from a trace file at the\n"
+        "                            recorded pace and log the input latency\n"
+        "  -P, --replay-fast=PATH    Like --replay but inject events as fast as\n"
+        "                            possible\n"
         "  -h, --help                Print this message and exit\n"
         "  -v, --verbose             Enable more detailed logging output on STDERR\n"
         "  -V, --version             Print the unl0kr version and exit\n");
@@ -84,6 +92,9 @@ void ul_cli_parse_opts(int argc, char *argv[], ul_cli_opts *opts) {
         { "config-override", required_argument, NULL, 'C' },
         { "geometry",        required_argument, NULL, 'g' },
         { "dpi",             required_argument, NULL, 'd' },
+        { "record",          required_argument, NULL, 'R' },
+        { "replay",          required_argument, NULL, 'p' },
+        { "replay-fast",     required_argument, NULL, 'P' },
         { "help",            no_argument,       NULL, 'h' },
         { "verbose",         no_argument,       NULL, 'v' },
         { "version",         no_argument,       NULL, 'V' },
@@ -92,7 +103,7 @@ void ul_cli_parse_opts(int argc, char *argv[], ul_cli_opts *opts) {
 
     int opt, index = 0;
 
-    while ((opt = getopt_long(argc, argv, "C:g:d:hvV", long_opts, &index)) != -1) {
+    while ((opt = getopt_long(argc, argv, "C:g:d:R:p:P:hvV", long_opts, &index)) != -1) {
         switch (opt) {
         case 'C':
             opts->config_files = realloc(opts->config_files, (opts->num_config_files + 1) * sizeof(char *));
@@ -117,6 +128,14 @@ void ul_cli_parse_opts(int argc, char *argv[], ul_cli_opts *opts) {
                 exit(EXIT_FAILURE);
             }
             break;
+        case 'R':
+            opts->record_file = optarg;
+            break;
+        case 'p':
+        case 'P':
+            opts->replay_file = optarg;
+            opts->replay_fast = opt == 'P';
+            break;
         case 'h':
             print_usage();
             exit(EXIT_SUCCESS);
@@ -27,6 +27,12 @@ typedef struct {
     int y_offset;
     /* DPI */
     int dpi;
+    /* Path of the file to record input events into or NULL */
+    const char *record_file;
+    /* Path of the file to replay input events from or NULL */
+    const char *replay_file;
+    /* If true, ignore the timestamps in replay_file and replay as fast as possible */
+    bool replay_fast;
     /* Verbose mode. If true, provide more detailed logging output on STDERR. */
     bool verbose;
 } ul_cli_opts;
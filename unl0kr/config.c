@@ -7,7 +7,9 @@
 #include "config.h"
 
 #include "../shared/config.h"
+#include "../shared/display.h"
 #include "../shared/log.h"
+#include "../shared/memory_display.h"
 #include "../squeek2lvgl/sq2lv.h"
 
 #include "lvgl/lvgl.h"
@@ -62,7 +64,8 @@ static int parsing_handler(void* user_data, const char* section, const char* key
                 return 1;
             }
         } else if (strcmp(key, "layout") == 0) {
-            sq2lv_layout_id_t id = sq2lv_find_layout_with_short_name(value);
+            sq2lv_layout_id_t id = (value[0] == '/')
+                ? sq2lv_load_layout(value) : sq2lv_find_layout_with_short_name(value);
             if (id != SQ2LV_LAYOUT_NONE) {
                 opts->keyboard.layout_id = id;
                 return 1;
@@ -86,18 +89,29 @@ static int parsing_handler(void* user_data, const char* section, const char* key
         }
     } else if (strcmp(section, "theme") == 0) {
         if (strcmp(key, "default") == 0) {
-            bbx_themes_theme_id_t id = bbx_themes_find_theme_with_name(value);
+            bbx_themes_theme_id_t id = (value[0] == '/')
+                ? bbx_themes_load_theme(value) : bbx_themes_find_theme_with_name(value);
             if (id != BBX_THEMES_THEME_NONE) {
                 opts->theme.default_id = id;
                 return 1;
             }
         } else if (strcmp(key, "alternate") == 0) {
-            bbx_themes_theme_id_t id = bbx_themes_find_theme_with_name(value);
+            bbx_themes_theme_id_t id = (value[0] == '/')
+                ? bbx_themes_load_theme(value) : bbx_themes_find_theme_with_name(value);
             if (id != BBX_THEMES_THEME_NONE) {
                 opts->theme.alternate_id = id;
                 return 1;
             }
         }
+    } else if (strcmp(section, "render") == 0) {
+        if (strcmp(key, "mode") == 0) {
+            if (bbx_display_find_render_mode_with_name(value, &(opts->render.mode))) {
+                return 1;
+            }
+        } else if (strcmp(key, "buffer_lines") == 0) {
+            opts->render.buffer_lines = strtoul(value, (char **)NULL, 10);
+            return 1;
+        }
     } else if (strcmp(section, "input") == 0) {
         if (strcmp(key, "keyboard") == 0) {
             if (bbx_config_parse_bool(value, &(opts->input.keyboard))) {
@@ -112,6 +126,32 @@ static int parsing_handler(void* user_data, const char* section, const char* key
                 return 1;
             }
         }
+    } else if (strcmp(section, "memory") == 0) {
+        if (strcmp(key, "path") == 0) {
+            char *path = strdup(value);
+            if (path) {
+                opts->memory.path = path;
+                return 1;
+            }
+        } else if (strcmp(key, "width") == 0) {
+            uint32_t width = strtoul(value, (char **)NULL, 10);
+            if (width > 0) {
+                opts->memory.width = width;
+                return 1;
+            }
+        } else if (strcmp(key, "height") == 0) {
+            uint32_t height = strtoul(value, (char **)NULL, 10);
+            if (height > 0) {
+                opts->memory.height = height;
+                return 1;
+            }
+        } else if (strcmp(key, "format") == 0) {
+            lv_color_format_t format = bbx_memory_display_find_format_with_name(value);
+            if (format != LV_COLOR_FORMAT_UNKNOWN) {
+                opts->memory.format = format;
+                return 1;
+            }
+        }
     } else if (strcmp(section, "quirks") == 0) {
         if (strcmp(key, "fbdev_force_refresh") == 0) {
             if (bbx_config_parse_bool(value, &(opts->quirks.fbdev_force_refresh))) {
@@ -148,9 +188,15 @@ void ul_config_init_opts(ul_config_opts *opts) {
     opts->textarea.bullet = LV_SYMBOL_BULLET;
     opts->theme.default_id = BBX_THEMES_THEME_BREEZY_DARK;
     opts->theme.alternate_id = BBX_THEMES_THEME_BREEZY_LIGHT;
+    opts->render.mode = LV_DISPLAY_RENDER_MODE_PARTIAL;
+    opts->render.buffer_lines = 0;
     opts->input.keyboard = true;
     opts->input.pointer = true;
     opts->input.touchscreen = true;
+    opts->memory.path = "/dev/shm/unl0kr.raw";
+    opts->memory.width = 1920;
+    opts->memory.height = 1080;
+    opts->memory.format = LV_COLOR_FORMAT_XRGB8888;
     opts->quirks.fbdev_force_refresh = false;
     opts->quirks.terminal_prevent_graphics_mode = false;
     opts->quirks.terminal_allow_keyboard_input = false;
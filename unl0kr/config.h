@@ -60,6 +60,16 @@ typedef struct {
     bbx_themes_theme_id_t alternate_id;
 } ul_config_opts_theme;
 
+/**
+ * Options related to rendering
+ */
+typedef struct {
+    /* Render mode */
+    lv_display_render_mode_t mode;
+    /* Number of rows to render at a time in partial mode, 0 for the default */
+    uint32_t buffer_lines;
+} ul_config_opts_render;
+
 /**
  * Options related to input devices
  */
@@ -72,6 +82,20 @@ typedef struct {
     bool touchscreen;
 } ul_config_opts_input;
 
+/**
+ * Options related to the memory backend
+ */
+typedef struct {
+    /* Path of the file to render into */
+    char *path;
+    /* Horizontal resolution in pixels */
+    uint32_t width;
+    /* Vertical resolution in pixels */
+    uint32_t height;
+    /* Pixel format */
+    lv_color_format_t format;
+} ul_config_opts_memory;
+
 /**
  * (Normally unneeded) quirky options
  */
@@ -96,8 +120,12 @@ typedef struct {
     ul_config_opts_textarea textarea;
     /* Options related to the theme */
     ul_config_opts_theme theme;
+    /* Options related to rendering */
+    ul_config_opts_render render;
     /* Options related to input devices */
     ul_config_opts_input input;
+    /* Options related to the memory backend */
+    ul_config_opts_memory memory;
     /* Options related to (normally unneeded) quirks */
     ul_config_opts_quirks quirks;
 } ul_config_opts;
@@ -0,0 +1,436 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#include "drm.h"
+
+#include "../shared/event_loop.h"
+#include "../shared/log.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <xf86drm.h>
+#include <xf86drmMode.h>
+
+#include <sys/epoll.h>
+#include <sys/mman.h>
+
+
+/**
+ * Defines
+ */
+
+#define MAX_CARDS 16
+#define NUM_BUFFERS 2
+#define FLIP_TIMEOUT_MS 100
+
+
+/**
+ * Static variables
+ */
+
+struct buffer {
+    uint32_t handle;
+    uint32_t pitch;
+    uint64_t size;
+    uint32_t fb_id;
+    uint8_t *map;
+    lv_draw_buf_t draw_buf;
+};
+
+static int fd = -1;
+static uint32_t connector_id = 0;
+static uint32_t crtc_id = 0;
+static drmModeModeInfo mode;
+
+static struct buffer buffers[NUM_BUFFERS];
+static bool is_flip_pending = false;
+
+
+/**
+ * Static prototypes
+ */
+
+/**
+ * Open the first DRM card that supports dumb buffers and has a connected connector.
+ *
+ * @return true if a card was found, false otherwise
+ */
+static bool open_card(void);
+
+/**
+ * Find the first connected connector on the current card and select its mode and CRTC.
+ *
+ * @return true if a connector was found, false otherwise
+ */
+static bool find_connector(void);
+
+/**
+ * Find a CRTC that can drive a connector.
+ *
+ * @param resources the card's resources
+ * @param connector the connector
+ * @return the CRTC's ID or 0 if none was found
+ */
+static uint32_t find_crtc(drmModeRes *resources, drmModeConnector *connector);
+
+/**
+ * Create, register and map a dumb buffer matching the current mode.
+ *
+ * @param buffer buffer to initialise
+ * @return true if the buffer was created successfully, false otherwise
+ */
+static bool create_buffer(struct buffer *buffer);
+
+/**
+ * Unmap, unregister and destroy a (possibly partially created) dumb buffer.
+ *
+ * @param buffer buffer to release
+ */
+static void destroy_buffer(struct buffer *buffer);
+
+/**
+ * Release all buffers and close the card.
+ */
+static void release_card(void);
+
+/**
+ * Find the buffer that contains a pixel map.
+ *
+ * @param px_map pixel map passed to the flush callback
+ * @return the buffer or NULL if the pixel map doesn't belong to any buffer
+ */
+static struct buffer *find_buffer(uint8_t *px_map);
+
+/**
+ * Flush callback. Schedules a page flip after the last area of a frame was rendered.
+ *
+ * @param disp display being flushed
+ * @param area area being flushed
+ * @param px_map rendered pixels
+ */
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
+
+/**
+ * Block until a pending page flip has completed.
+ *
+ * @param disp display waiting for its flush to complete
+ */
+static void flush_wait_cb(lv_display_t *disp);
+
+/**
+ * Handle a completed page flip.
+ *
+ * @param fd card file descriptor
+ * @param sequence vblank sequence number
+ * @param tv_sec seconds part of the flip timestamp
+ * @param tv_usec microseconds part of the flip timestamp
+ * @param user_data the display
+ */
+static void page_flip_handler(int fd, unsigned int sequence, unsigned int tv_sec, unsigned int tv_usec, void *user_data);
+
+/**
+ * Read and dispatch pending DRM events.
+ */
+static void handle_events(void);
+
+/**
+ * Handle readability of the card's file descriptor in the event loop.
+ *
+ * @param fd card file descriptor
+ * @param events mask of epoll events that occurred
+ * @param user_data unused
+ */
+static void card_fd_ready_cb(int fd, uint32_t events, void *user_data);
+
+
+/**
+ * Static functions
+ */
+
+static bool open_card(void) {
+    char path[32];
+
+    for (int i = 0; i < MAX_CARDS; ++i) {
+        snprintf(path, sizeof(path), "/dev/dri/card%d", i);
+
+        fd = open(path, O_RDWR | O_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+
+        uint64_t has_dumb = 0;
+        if (drmGetCap(fd, DRM_CAP_DUMB_BUFFER, &has_dumb) == 0 && has_dumb && find_connector()) {
+            bbx_log(BBX_LOG_LEVEL_VERBOSE, "Using DRM card %s with mode %s", path, mode.name);
+            return true;
+        }
+
+        close(fd);
+        fd = -1;
+    }
+
+    return false;
+}
+
+static bool find_connector(void) {
+    drmModeRes *resources = drmModeGetResources(fd);
+    if (!resources) {
+        return false;
+    }
+
+    bool found = false;
+
+    for (int i = 0; i < resources->count_connectors && !found; ++i) {
+        drmModeConnector *connector = drmModeGetConnector(fd, resources->connectors[i]);
+        if (!connector) {
+            continue;
+        }
+
+        if (connector->connection == DRM_MODE_CONNECTED && connector->count_modes > 0) {
+            crtc_id = find_crtc(resources, connector);
+            if (crtc_id != 0) {
+                /* Prefer the preferred mode, otherwise use the first one */
+                mode = connector->modes[0];
+                for (int j = 0; j < connector->count_modes; ++j) {
+                    if (connector->modes[j].type & DRM_MODE_TYPE_PREFERRED) {
+                        mode = connector->modes[j];
+                        break;
+                    }
+                }
+                connector_id = connector->connector_id;
+                found = true;
+            }
+        }
+
+        drmModeFreeConnector(connector);
+    }
+
+    drmModeFreeResources(resources);
+    return found;
+}
+
+static uint32_t find_crtc(drmModeRes *resources, drmModeConnector *connector) {
+    /* Reuse the CRTC of the currently attached encoder if there is one */
+    if (connector->encoder_id) {
+        drmModeEncoder *encoder = drmModeGetEncoder(fd, connector->encoder_id);
+        if (encoder) {
+            uint32_t id = encoder->crtc_id;
+            drmModeFreeEncoder(encoder);
+            if (id != 0) {
+                return id;
+            }
+        }
+    }
+
+    /* Otherwise use the first CRTC any of the connector's encoders can drive */
+    for (int i = 0; i < connector->count_encoders; ++i) {
+        drmModeEncoder *encoder = drmModeGetEncoder(fd, connector->encoders[i]);
+        if (!encoder) {
+            continue;
+        }
+
+        for (int j = 0; j < resources->count_crtcs; ++j) {
+            if (encoder->possible_crtcs & (1 << j)) {
+                drmModeFreeEncoder(encoder);
+                return resources->crtcs[j];
+            }
+        }
+
+        drmModeFreeEncoder(encoder);
+    }
+
+    return 0;
+}
+
+static bool create_buffer(struct buffer *buffer) {
+    struct drm_mode_create_dumb create = { .width = mode.hdisplay, .height = mode.vdisplay, .bpp = 32 };
+    if (drmIoctl(fd, DRM_IOCTL_MODE_CREATE_DUMB, &create) < 0) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not create dumb buffer: %s", strerror(errno));
+        return false;
+    }
+    buffer->handle = create.handle;
+    buffer->pitch = create.pitch;
+    buffer->size = create.size;
+
+    if (drmModeAddFB(fd, mode.hdisplay, mode.vdisplay, 24, 32, buffer->pitch, buffer->handle, &buffer->fb_id) != 0) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not add framebuffer: %s", strerror(errno));
+        buffer->fb_id = 0;
+        destroy_buffer(buffer);
+        return false;
+    }
+
+    struct drm_mode_map_dumb map = { .handle = buffer->handle };
+    if (drmIoctl(fd, DRM_IOCTL_MODE_MAP_DUMB, &map) < 0) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not prepare dumb buffer mapping: %s", strerror(errno));
+        destroy_buffer(buffer);
+        return false;
+    }
+
+    buffer->map = mmap(NULL, buffer->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, map.offset);
+    if (buffer->map == MAP_FAILED) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not map dumb buffer: %s", strerror(errno));
+        buffer->map = NULL;
+        destroy_buffer(buffer);
+        return false;
+    }
+
+    /* Rows may be padded, so let LVGL render with the buffer's own stride */
+    if (lv_draw_buf_init(&buffer->draw_buf, mode.hdisplay, mode.vdisplay, LV_COLOR_FORMAT_XRGB8888,
+            buffer->pitch, buffer->map, buffer->size) != LV_RESULT_OK) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not use dumb buffer with pitch %u as draw buffer", buffer->pitch);
+        destroy_buffer(buffer);
+        return false;
+    }
+
+    memset(buffer->map, 0, buffer->size);
+    return true;
+}
+
+static void destroy_buffer(struct buffer *buffer) {
+    if (buffer->map) {
+        munmap(buffer->map, buffer->size);
+    }
+    if (buffer->fb_id) {
+        drmModeRmFB(fd, buffer->fb_id);
+    }
+    if (buffer->handle) {
+        struct drm_mode_destroy_dumb destroy = { .handle = buffer->handle };
+        drmIoctl(fd, DRM_IOCTL_MODE_DESTROY_DUMB, &destroy);
+    }
+    memset(buffer, 0, sizeof(*buffer));
+}
+
+static void release_card(void) {
+    for (int i = 0; i < NUM_BUFFERS; ++i) {
+        destroy_buffer(&buffers[i]);
+    }
+    close(fd);
+    fd = -1;
+}
+
+static struct buffer *find_buffer(uint8_t *px_map) {
+    for (int i = 0; i < NUM_BUFFERS; ++i) {
+        if (px_map >= buffers[i].map && px_map < buffers[i].map + buffers[i].size) {
+            return &buffers[i];
+        }
+    }
+    return NULL;
+}
+
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    LV_UNUSED(area);
+
+    /* Areas are rendered straight into the buffer, so only the end of the frame needs handling */
+    if (!lv_display_flush_is_last(disp)) {
+        lv_display_flush_ready(disp);
+        return;
+    }
+
+    struct buffer *buffer = find_buffer(px_map);
+    if (!buffer) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not find buffer for flushed frame");
+        lv_display_flush_ready(disp);
+        return;
+    }
+
+    /* Present the buffer on the next vblank and only signal readiness once it is on screen */
+    if (drmModePageFlip(fd, crtc_id, buffer->fb_id, DRM_MODE_PAGE_FLIP_EVENT, disp) != 0) {
+        bbx_log(BBX_LOG_LEVEL_WARNING, "Could not schedule page flip: %s", strerror(errno));
+        lv_display_flush_ready(disp);
+        return;
+    }
+
+    is_flip_pending = true;
+}
+
+static void flush_wait_cb(lv_display_t *disp) {
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+
+    while (is_flip_pending) {
+        int result = poll(&pfd, 1, FLIP_TIMEOUT_MS);
+        if (result > 0) {
+            handle_events();
+        } else if (result == 0 || errno != EINTR) {
+            /* Don't stall rendering forever if the flip event got lost */
+            bbx_log(BBX_LOG_LEVEL_WARNING, "Timed out waiting for page flip");
+            is_flip_pending = false;
+            lv_display_flush_ready(disp);
+        }
+    }
+}
+
+static void page_flip_handler(int fd, unsigned int sequence, unsigned int tv_sec, unsigned int tv_usec, void *user_data) {
+    LV_UNUSED(fd);
+    LV_UNUSED(sequence);
+    LV_UNUSED(tv_sec);
+    LV_UNUSED(tv_usec);
+
+    is_flip_pending = false;
+    lv_display_flush_ready(user_data);
+}
+
+static void handle_events(void) {
+    drmEventContext context = {
+        .version = 2,
+        .page_flip_handler = page_flip_handler
+    };
+    drmHandleEvent(fd, &context);
+}
+
+static void card_fd_ready_cb(int fd, uint32_t events, void *user_data) {
+    LV_UNUSED(fd);
+    LV_UNUSED(events);
+    LV_UNUSED(user_data);
+    handle_events();
+}
+
+
+/**
+ * Public functions
+ */
+
+lv_display_t *ul_drm_create(void) {
+    if (!open_card()) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not find DRM card with connected connector");
+        return NULL;
+    }
+
+    for (int i = 0; i < NUM_BUFFERS; ++i) {
+        if (!create_buffer(&buffers[i])) {
+            release_card();
+            return NULL;
+        }
+    }
+
+    /* Scan out the second buffer while LVGL renders the first frame into the first one */
+    if (drmModeSetCrtc(fd, crtc_id, buffers[1].fb_id, 0, 0, &connector_id, 1, &mode) != 0) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Could not set CRTC mode: %s", strerror(errno));
+        release_card();
+        return NULL;
+    }
+
+    lv_display_t *disp = lv_display_create(mode.hdisplay, mode.vdisplay);
+    if (!disp) {
+        release_card();
+        return NULL;
+    }
+
+    /* In direct mode with two buffers, LVGL copies the areas redrawn in the previous frame
+     * into the new back buffer instead of re-rendering the whole screen */
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);
+    lv_display_set_draw_buffers(disp, &buffers[0].draw_buf, &buffers[1].draw_buf);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_display_set_flush_wait_cb(disp, flush_wait_cb);
+
+    /* Complete page flips while idle without waiting for the next frame */
+    bbx_event_loop_add_fd(fd, EPOLLIN, card_fd_ready_cb, NULL);
+
+    return disp;
+}
@@ -0,0 +1,21 @@
+/**
+ * Copyright 2026 Johannes Marbach
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#ifndef UL_DRM_H
+#define UL_DRM_H
+
+#include "lvgl/lvgl.h"
+
+/**
+ * Create a display on the first DRM card that has a connected connector. The display renders
+ * directly into two dumb buffers and presents them with vblank-synchronised page flips. Only
+ * the regions redrawn in a frame are rendered and copied forward into the other buffer.
+ *
+ * @return the display or NULL if no suitable card was found
+ */
+lv_display_t *ul_drm_create(void);
+
+#endif /* UL_DRM_H */
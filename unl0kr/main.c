@@ -7,18 +7,25 @@
 #include "backends.h"
 #include "command_line.h"
 #include "config.h"
+#if LV_USE_LINUX_DRM
+#include "drm.h"
+#endif /* LV_USE_LINUX_DRM */
 #include "unl0kr.h"
 #include "terminal.h"
 
+#include "../shared/display.h"
+#include "../shared/event_loop.h"
 #include "../shared/indev.h"
 #include "../shared/log.h"
+#include "../shared/memory_display.h"
+#include "../shared/replay.h"
 #include "../shared/theme.h"
 #include "../shared/themes.h"
+#include "../shared/tick.h"
 #include "../squeek2lvgl/sq2lv.h"
 
 #include "lvgl/lvgl.h"
 
-#include <pthread.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -47,13 +54,6 @@ lv_obj_t *keyboard = NULL;
  * Static prototypes
  */
 
-/**
- * Function to invoke in the tick generation thread.
- *
- * @param args unused
-*/
-static void *tick_thread (void *args);
-
 /**
  * Handle LV_EVENT_CLICKED events from the theme toggle button.
  *
@@ -182,11 +182,23 @@ static void textarea_ready_cb(lv_event_t *event);
  */
 static void print_password_and_exit(lv_obj_t *textarea);
 
+/**
+ * Hide the on-screen keyboard if autohide is enabled and a physical keyboard was found.
+ */
+static void auto_connect_finished_cb(void);
+
 /**
  * Shuts down the device.
  */
 static void shutdown(void);
 
+/**
+ * Callback for the inactivity timeout timer.
+ *
+ * @param timer the timer object
+ */
+static void timeout_timer_cb(lv_timer_t *timer);
+
 /**
  * Handle termination signals sent to the process.
  *
@@ -199,16 +211,6 @@ static void sigaction_handler(int signum);
  * Static functions
  */
 
-
-static void *tick_thread (void *args) {
-    LV_UNUSED(args);
-    while (1) {
-        usleep(5 * 1000); /* Sleep for 5 millisecond */
-        lv_tick_inc(5); /* Tell LVGL that 5 milliseconds have elapsed */
-    }
-    return NULL;
-}
-
 static void toggle_theme_btn_clicked_cb(lv_event_t *event) {
     LV_UNUSED(event);
     toggle_theme();
@@ -224,7 +226,7 @@ static void set_theme(bool is_alternate) {
 }
 
 static const bbx_theme * get_theme(bool is_alternate) {
-    return bbx_themes_themes[is_alternate ? conf_opts.theme.alternate_id : conf_opts.theme.default_id];
+    return bbx_themes_get_theme(is_alternate ? conf_opts.theme.alternate_id : conf_opts.theme.default_id);
 }
 
 static void toggle_pw_btn_clicked_cb(lv_event_t *event) {
@@ -344,18 +346,45 @@ static void print_password_and_exit(lv_obj_t *textarea) {
     lv_obj_set_size(rect, LV_PCT(100), LV_PCT(100));
     lv_obj_set_pos(rect, 0, 0);
     lv_obj_set_style_bg_opa(rect, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_bg_color(rect , lv_color_hex(get_theme(is_alternate_theme)->window.bg_color), LV_PART_MAIN);
+    lv_obj_set_style_bg_color(rect , get_theme(is_alternate_theme)->window.bg_color, LV_PART_MAIN);
     lv_refr_now(lv_display_get_default()); /* Force the screen to be drawn */
 
     /* Trigger SIGTERM to exit */
     sigaction_handler(SIGTERM);
 }
 
+static void auto_connect_finished_cb(void) {
+    if (!conf_opts.keyboard.autohide || is_keyboard_hidden || !bbx_indev_is_keyboard_connected()) {
+        return;
+    }
+
+    is_keyboard_hidden = true;
+
+    /* Devices are usually connected once the UI exists but can also be connected synchronously before that.
+     * Either way this happens during startup, so move the keyboard out of view without sliding it. */
+    if (keyboard) {
+        lv_obj_set_y(keyboard, lv_obj_get_height(keyboard));
+    }
+}
+
 static void shutdown(void) {
     sync();
     reboot(RB_POWER_OFF);
 }
 
+static void timeout_timer_cb(lv_timer_t *timer) {
+    uint32_t timeout = conf_opts.general.timeout * 1000; /* ms */
+    uint32_t inactive_time = lv_disp_get_inactive_time(NULL);
+
+    if (inactive_time >= timeout) {
+        shutdown();
+        return;
+    }
+
+    /* Check again once the remaining time would have elapsed */
+    lv_timer_set_period(timer, timeout - inactive_time);
+}
+
 static void sigaction_handler(int signum) {
     LV_UNUSED(signum);
     ul_terminal_reset_current_terminal();
@@ -387,19 +416,21 @@ int main(int argc, char *argv[]) {
 
     /* Prepare current TTY and clean up on termination */
     ul_terminal_prepare_current_terminal(!conf_opts.quirks.terminal_prevent_graphics_mode, !conf_opts.quirks.terminal_allow_keyboard_input);
-    struct sigaction action;
-    memset(&action, 0, sizeof(action));
-    action.sa_handler = sigaction_handler;
-    sigaction(SIGINT, &action, NULL);
-    sigaction(SIGTERM, &action, NULL);
+    const int signums[] = { SIGINT, SIGTERM };
+    if (!bbx_event_loop_init() || !bbx_event_loop_handle_signals(signums, 2, sigaction_handler)) {
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = sigaction_handler;
+        sigaction(SIGINT, &action, NULL);
+        sigaction(SIGTERM, &action, NULL);
+    }
 
     /* Initialise LVGL and set up logging callback */
     lv_init();
     lv_log_register_print_cb(bbx_log_print_cb);
 
-    /* Start the tick thread */
-    pthread_t ticker;
-    pthread_create(&ticker, NULL, tick_thread, NULL);
+    /* Use the monotonic clock as tick source */
+    lv_tick_set_cb(bbx_tick_get);
 
     /* Initialise display */
     lv_display_t *disp = NULL;
@@ -409,7 +440,7 @@ int main(int argc, char *argv[]) {
         bbx_log(BBX_LOG_LEVEL_VERBOSE, "Using framebuffer backend");
         disp = lv_linux_fbdev_create();
         lv_linux_fbdev_set_file(disp, "/dev/fb0");
-        if (conf_opts.quirks.fbdev_force_refresh) {
+        if (conf_opts.quirks.fbdev_force_refresh && !bbx_display_set_fbdev_force_refresh(disp, "/dev/fb0")) {
             lv_linux_fbdev_set_force_refresh(disp, true);
         }
         break;
@@ -417,15 +448,24 @@ int main(int argc, char *argv[]) {
 #if LV_USE_LINUX_DRM
     case UL_BACKENDS_BACKEND_DRM:
         bbx_log(BBX_LOG_LEVEL_VERBOSE, "Using DRM backend");
-        disp = lv_linux_drm_create();
-        lv_linux_drm_set_file(disp, "/dev/dri/card0", -1);
+        disp = ul_drm_create();
         break;
 #endif /* LV_USE_LINUX_DRM */
+    case UL_BACKENDS_BACKEND_MEMORY:
+        bbx_log(BBX_LOG_LEVEL_VERBOSE, "Using memory backend");
+        disp = bbx_memory_display_create(conf_opts.memory.path, conf_opts.memory.width, conf_opts.memory.height,
+            conf_opts.memory.format);
+        break;
     default:
         bbx_log(BBX_LOG_LEVEL_ERROR, "Unable to find suitable backend");
         exit(EXIT_FAILURE);
     }
 
+    if (!disp) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Unable to initialise display");
+        exit(EXIT_FAILURE);
+    }
+
     /* Override display properties with command line options if necessary */
     lv_display_set_offset(disp, cli_opts.x_offset, cli_opts.y_offset);
     if (cli_opts.hor_res > 0 || cli_opts.ver_res > 0) {
@@ -440,30 +480,42 @@ int main(int argc, char *argv[]) {
     const uint32_t hor_res = lv_disp_get_hor_res(disp);
     const uint32_t ver_res = lv_disp_get_ver_res(disp);
 
+    /* Start recording input events if requested */
+    if (cli_opts.record_file) {
+        bbx_replay_start_recording(cli_opts.record_file);
+    }
+
     /* Prepare for routing physical keyboard input into the textarea */
     lv_group_t *keyboard_input_group = lv_group_create();
     bbx_indev_set_keyboard_input_group(keyboard_input_group);
 
-    /* Start input device monitor and auto-connect available devices */
+    /* Start input device monitor and auto-connect available devices. Hide the on-screen keyboard
+     * if a physical keyboard is connected. */
+    bbx_indev_set_auto_connect_finished_cb(auto_connect_finished_cb);
     bbx_indev_start_monitor_and_autoconnect(conf_opts.input.keyboard, conf_opts.input.pointer, conf_opts.input.touchscreen);
 
-    /* Hide the on-screen keyboard by default if a physical keyboard is connected */
-    if (conf_opts.keyboard.autohide && bbx_indev_is_keyboard_connected()) {
-        is_keyboard_hidden = true;
+    /* Figure out a few numbers for sizing and positioning */
+    const int base_keyboard_height = ver_res > hor_res ? ver_res / 3 : ver_res / 2; /* Height for 4 rows */
+    const int keyboard_height = base_keyboard_height * 1.25; /* Add space for an extra top row */
+    const int padding = keyboard_height / 10;
+    const int textarea_container_max_width = LV_MIN(hor_res, ver_res);
+
+#if LV_USE_LINUX_FBDEV
+    /* Size the render buffers for the keyboard, the largest region that is redrawn while typing. The
+     * other backends render straight into their mapped buffers. */
+    if (conf_opts.general.backend == UL_BACKENDS_BACKEND_FBDEV) {
+        uint32_t buffer_lines = conf_opts.render.buffer_lines > 0 ? conf_opts.render.buffer_lines : keyboard_height;
+        bbx_display_set_render_buffers(disp, conf_opts.render.mode, buffer_lines);
     }
+#endif /* LV_USE_LINUX_FBDEV */
 
-    /* Initialise theme */
+    /* Initialise theme and prepare the other one so that toggling doesn't need to build its styles */
     set_theme(is_alternate_theme);
+    bbx_theme_prepare(get_theme(!is_alternate_theme));
 
     /* Prevent scrolling when keyboard is off-screen */
     lv_obj_clear_flag(lv_scr_act(), LV_OBJ_FLAG_SCROLLABLE);
 
-    /* Figure out a few numbers for sizing and positioning */
-    const int base_keyboard_height = ver_res > hor_res ? ver_res / 3 : ver_res / 2; /* Height for 4 rows */
-    const int keyboard_height = base_keyboard_height * 1.25; /* Add space for an extra top row */
-    const int padding = keyboard_height / 10;
-    const int textarea_container_max_width = LV_MIN(hor_res, ver_res);
-
     /* Main flexbox */
     lv_obj_t *container = lv_obj_create(lv_scr_act());
     lv_obj_set_flex_flow(container, LV_FLEX_FLOW_COLUMN);
@@ -497,6 +549,9 @@ int main(int argc, char *argv[]) {
     /* Keyboard layout dropdown */
     lv_obj_t *layout_dropdown = lv_dropdown_create(header);
     lv_dropdown_set_options(layout_dropdown, sq2lv_layout_short_names);
+    for (int i = sq2lv_num_layouts; i < sq2lv_get_num_layouts(); ++i) {
+        lv_dropdown_add_option(layout_dropdown, sq2lv_get_layout(i)->short_name, LV_DROPDOWN_POS_LAST);
+    }
     lv_obj_add_event_cb(layout_dropdown, layout_dropdown_value_changed_cb, LV_EVENT_VALUE_CHANGED, NULL);
     lv_obj_set_width(layout_dropdown, 90);
 
@@ -585,15 +640,19 @@ int main(int argc, char *argv[]) {
         lv_keyboard_set_popovers(keyboard, true);
     }
 
-    /* Periodically run timer / task handler */
-    uint32_t timeout = conf_opts.general.timeout * 1000; /* ms */
-    while(1) {
-        if (!timeout || lv_disp_get_inactive_time(NULL) < timeout) {
-            lv_timer_periodic_handler();
-        } else if (timeout) {
-            shutdown();
-        }
+    /* Shut down after the configured period of inactivity */
+    if (conf_opts.general.timeout) {
+        lv_timer_create(timeout_timer_cb, conf_opts.general.timeout * 1000, NULL);
     }
 
+    /* Replay input events if requested */
+    if (cli_opts.replay_file && !bbx_replay_start(cli_opts.replay_file, cli_opts.replay_fast, keyboard_input_group)) {
+        bbx_log(BBX_LOG_LEVEL_ERROR, "Unable to replay input trace");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Run timers and handle input until we exit */
+    bbx_event_loop_run();
+
     return 0;
 }
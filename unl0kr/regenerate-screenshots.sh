@@ -6,6 +6,7 @@ fb_depth=8
 fb_format=rgba
 
 executable=$1
+backend=${2:-fbdev} # Use "memory" to render headlessly without touching /dev/fb0
 outdir=screenshots
 config=unl0kr-screenshots.conf
 
@@ -43,6 +44,7 @@ function write_config() {
     cat << EOF > $config
 [general]
 animations=true
+backend=$backend
 
 [keyboard]
 autohide=false
@@ -60,6 +62,17 @@ keyboard=true
 pointer=false
 touchscreen=false
 EOF
+
+    if [[ $backend == memory ]]; then
+        cat << EOF >> $config
+
+[memory]
+path=$outdir/memory.raw
+width=${2%x*}
+height=${2#*x}
+format=argb8888
+EOF
+    fi
 }
 
 function nuke_config() {
@@ -74,16 +87,28 @@ mkdir "$outdir"
 readme="# Unl0kr themes"$'\n'
 
 for theme in ${themes[@]}; do
-    write_config $theme
-
     readme="$readme"$'\n'"## $theme"$'\n\n'
     
     for res in ${resolutions[@]}; do
-        CRYPTTAB_SOURCE=/dev/sda1 $executable -g $res -C $config &
+        write_config $theme $res
+
+        if [[ $backend == memory ]]; then
+            CRYPTTAB_SOURCE=/dev/sda1 $executable -C $config &
+        else
+            CRYPTTAB_SOURCE=/dev/sda1 $executable -g $res -C $config &
+        fi
         pid=$!
 
         sleep 3 # Wait for UI to render
 
+        if [[ $backend == memory ]]; then
+            # The memory backend renders at exactly the target resolution in ARGB8888 (BGRA byte order)
+            convert -size $res -depth 8 bgra:"$outdir/memory.raw" -alpha off "$outdir/$theme-$res.png"
+            kill -15 $pid
+            readme="$readme<img src=\"$theme-$res.png\" alt=\"$res\" height=\"300\"/>"$'\n'
+            continue
+        fi
+
         cat /dev/fb0 > "$outdir/$theme-$res"
         convert -size $fb_res -depth $fb_depth $fb_format:"$outdir/$theme-$res" -crop $res+0+0 "$outdir/$theme-$res.png"
         rm "$outdir/$theme-$res"
@@ -95,4 +120,5 @@ for theme in ${themes[@]}; do
     done
 done
 
+rm -f "${outdir:?}/memory.raw"
 echo -n "$readme" > "$outdir/README.md"
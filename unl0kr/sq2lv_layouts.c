@@ -48,6 +48,14 @@ static const int switcher_dests_lower_us[] = { \
     1, 2 \
 };
 
+static const uint8_t key_classes_lower_us[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 1, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Uppercase letters - generated from upper */
 
 static const int num_keys_upper_us = 44;
@@ -82,6 +90,14 @@ static const int switcher_dests_upper_us[] = { \
     0, 2 \
 };
 
+static const uint8_t key_classes_upper_us[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Numbers / symbols - generated from numbers */
 
 static const int num_keys_numbers_us = 36;
@@ -116,6 +132,14 @@ static const int switcher_dests_numbers_us[] = { \
     3, 0 \
 };
 
+static const uint8_t key_classes_numbers_us[] = { \
+    0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 3, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Symbols - generated from symbols */
 
 static const int num_keys_symbols_us = 36;
@@ -150,6 +174,14 @@ static const int switcher_dests_symbols_us[] = { \
     2, 0 \
 };
 
+static const uint8_t key_classes_symbols_us[] = { \
+    0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer array */
 
 static const int num_layers_us = 4;
@@ -163,7 +195,8 @@ static const sq2lv_layer_t layers_us[] = {
         .modifier_idxs = modifier_idxs_lower_us,
         .num_switchers = num_switchers_lower_us,
         .switcher_idxs = switcher_idxs_lower_us,
-        .switcher_dests = switcher_dests_lower_us
+        .switcher_dests = switcher_dests_lower_us,
+        .key_classes = key_classes_lower_us
     },
     {
         .num_keys = num_keys_upper_us,
@@ -173,7 +206,8 @@ static const sq2lv_layer_t layers_us[] = {
         .modifier_idxs = modifier_idxs_upper_us,
         .num_switchers = num_switchers_upper_us,
         .switcher_idxs = switcher_idxs_upper_us,
-        .switcher_dests = switcher_dests_upper_us
+        .switcher_dests = switcher_dests_upper_us,
+        .key_classes = key_classes_upper_us
     },
     {
         .num_keys = num_keys_numbers_us,
@@ -183,7 +217,8 @@ static const sq2lv_layer_t layers_us[] = {
         .modifier_idxs = modifier_idxs_numbers_us,
         .num_switchers = num_switchers_numbers_us,
         .switcher_idxs = switcher_idxs_numbers_us,
-        .switcher_dests = switcher_dests_numbers_us
+        .switcher_dests = switcher_dests_numbers_us,
+        .key_classes = key_classes_numbers_us
     },
     {
         .num_keys = num_keys_symbols_us,
@@ -193,7 +228,8 @@ static const sq2lv_layer_t layers_us[] = {
         .modifier_idxs = modifier_idxs_symbols_us,
         .num_switchers = num_switchers_symbols_us,
         .switcher_idxs = switcher_idxs_symbols_us,
-        .switcher_dests = switcher_dests_symbols_us
+        .switcher_dests = switcher_dests_symbols_us,
+        .key_classes = key_classes_symbols_us
     }
 };
 
@@ -238,6 +274,14 @@ static const int switcher_dests_lower_de[] = { \
     1, 2, 4 \
 };
 
+static const uint8_t key_classes_lower_de[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 1, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Uppercase letters - generated from upper */
 
 static const int num_keys_upper_de = 46;
@@ -272,6 +316,14 @@ static const int switcher_dests_upper_de[] = { \
     0, 2, 4 \
 };
 
+static const uint8_t key_classes_upper_de[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Numbers / symbols - generated from numbers */
 
 static const int num_keys_numbers_de = 38;
@@ -306,6 +358,14 @@ static const int switcher_dests_numbers_de[] = { \
     3, 0, 4 \
 };
 
+static const uint8_t key_classes_numbers_de[] = { \
+    0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 3, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Symbols - generated from symbols */
 
 static const int num_keys_symbols_de = 38;
@@ -340,6 +400,14 @@ static const int switcher_dests_symbols_de[] = { \
     2, 0, 4 \
 };
 
+static const uint8_t key_classes_symbols_de[] = { \
+    0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Special characters - generated from eschars */
 
 static const int num_keys_special_de = 38;
@@ -374,6 +442,14 @@ static const int switcher_dests_special_de[] = { \
     2, 0, 0 \
 };
 
+static const uint8_t key_classes_special_de[] = { \
+    0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer array */
 
 static const int num_layers_de = 5;
@@ -387,7 +463,8 @@ static const sq2lv_layer_t layers_de[] = {
         .modifier_idxs = modifier_idxs_lower_de,
         .num_switchers = num_switchers_lower_de,
         .switcher_idxs = switcher_idxs_lower_de,
-        .switcher_dests = switcher_dests_lower_de
+        .switcher_dests = switcher_dests_lower_de,
+        .key_classes = key_classes_lower_de
     },
     {
         .num_keys = num_keys_upper_de,
@@ -397,7 +474,8 @@ static const sq2lv_layer_t layers_de[] = {
         .modifier_idxs = modifier_idxs_upper_de,
         .num_switchers = num_switchers_upper_de,
         .switcher_idxs = switcher_idxs_upper_de,
-        .switcher_dests = switcher_dests_upper_de
+        .switcher_dests = switcher_dests_upper_de,
+        .key_classes = key_classes_upper_de
     },
     {
         .num_keys = num_keys_numbers_de,
@@ -407,7 +485,8 @@ static const sq2lv_layer_t layers_de[] = {
         .modifier_idxs = modifier_idxs_numbers_de,
         .num_switchers = num_switchers_numbers_de,
         .switcher_idxs = switcher_idxs_numbers_de,
-        .switcher_dests = switcher_dests_numbers_de
+        .switcher_dests = switcher_dests_numbers_de,
+        .key_classes = key_classes_numbers_de
     },
     {
         .num_keys = num_keys_symbols_de,
@@ -417,7 +496,8 @@ static const sq2lv_layer_t layers_de[] = {
         .modifier_idxs = modifier_idxs_symbols_de,
         .num_switchers = num_switchers_symbols_de,
         .switcher_idxs = switcher_idxs_symbols_de,
-        .switcher_dests = switcher_dests_symbols_de
+        .switcher_dests = switcher_dests_symbols_de,
+        .key_classes = key_classes_symbols_de
     },
     {
         .num_keys = num_keys_special_de,
@@ -427,7 +507,8 @@ static const sq2lv_layer_t layers_de[] = {
         .modifier_idxs = modifier_idxs_special_de,
         .num_switchers = num_switchers_special_de,
         .switcher_idxs = switcher_idxs_special_de,
-        .switcher_dests = switcher_dests_special_de
+        .switcher_dests = switcher_dests_special_de,
+        .key_classes = key_classes_special_de
     }
 };
 
@@ -472,6 +553,14 @@ static const int switcher_dests_lower_es[] = { \
     1, 2, 4 \
 };
 
+static const uint8_t key_classes_lower_es[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 1, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Uppercase letters - generated from upper */
 
 static const int num_keys_upper_es = 47;
@@ -506,6 +595,14 @@ static const int switcher_dests_upper_es[] = { \
     0, 2, 4 \
 };
 
+static const uint8_t key_classes_upper_es[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Numbers / symbols - generated from numbers */
 
 static const int num_keys_numbers_es = 38;
@@ -540,6 +637,14 @@ static const int switcher_dests_numbers_es[] = { \
     3, 0, 4 \
 };
 
+static const uint8_t key_classes_numbers_es[] = { \
+    0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 3, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Symbols - generated from symbols */
 
 static const int num_keys_symbols_es = 38;
@@ -574,6 +679,14 @@ static const int switcher_dests_symbols_es[] = { \
     2, 0, 4 \
 };
 
+static const uint8_t key_classes_symbols_es[] = { \
+    0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer: Special characters - generated from eschars */
 
 static const int num_keys_special_es = 38;
@@ -608,6 +721,14 @@ static const int switcher_dests_special_es[] = { \
     2, 0, 0 \
 };
 
+static const uint8_t key_classes_special_es[] = { \
+    0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0, 0 \
+};
+
 /* Layer array */
 
 static const int num_layers_es = 5;
@@ -621,7 +742,8 @@ static const sq2lv_layer_t layers_es[] = {
         .modifier_idxs = modifier_idxs_lower_es,
         .num_switchers = num_switchers_lower_es,
         .switcher_idxs = switcher_idxs_lower_es,
-        .switcher_dests = switcher_dests_lower_es
+        .switcher_dests = switcher_dests_lower_es,
+        .key_classes = key_classes_lower_es
     },
     {
         .num_keys = num_keys_upper_es,
@@ -631,7 +753,8 @@ static const sq2lv_layer_t layers_es[] = {
         .modifier_idxs = modifier_idxs_upper_es,
         .num_switchers = num_switchers_upper_es,
         .switcher_idxs = switcher_idxs_upper_es,
-        .switcher_dests = switcher_dests_upper_es
+        .switcher_dests = switcher_dests_upper_es,
+        .key_classes = key_classes_upper_es
     },
     {
         .num_keys = num_keys_numbers_es,
@@ -641,7 +764,8 @@ static const sq2lv_layer_t layers_es[] = {
         .modifier_idxs = modifier_idxs_numbers_es,
         .num_switchers = num_switchers_numbers_es,
         .switcher_idxs = switcher_idxs_numbers_es,
-        .switcher_dests = switcher_dests_numbers_es
+        .switcher_dests = switcher_dests_numbers_es,
+        .key_classes = key_classes_numbers_es
     },
     {
         .num_keys = num_keys_symbols_es,
@@ -651,7 +775,8 @@ static const sq2lv_layer_t layers_es[] = {
         .modifier_idxs = modifier_idxs_symbols_es,
         .num_switchers = num_switchers_symbols_es,
         .switcher_idxs = switcher_idxs_symbols_es,
-        .switcher_dests = switcher_dests_symbols_es
+        .switcher_dests = switcher_dests_symbols_es,
+        .key_classes = key_classes_symbols_es
     },
     {
         .num_keys = num_keys_special_es,
@@ -661,7 +786,8 @@ static const sq2lv_layer_t layers_es[] = {
         .modifier_idxs = modifier_idxs_special_es,
         .num_switchers = num_switchers_special_es,
         .switcher_idxs = switcher_idxs_special_es,
-        .switcher_dests = switcher_dests_special_es
+        .switcher_dests = switcher_dests_special_es,
+        .key_classes = key_classes_special_es
     }
 };
 
@@ -706,6 +832,14 @@ static const int switcher_dests_lower_fr[] = { \
     1, 2, 4 \
 };
 
+static const uint8_t key_classes_lower_fr[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 1, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0 \
+};
+
 /* Layer: Uppercase letters - generated from upper */
 
 static const int num_keys_upper_fr = 45;
@@ -740,6 +874,14 @@ static const int switcher_dests_upper_fr[] = { \
     0, 2, 4 \
 };
 
+static const uint8_t key_classes_upper_fr[] = { \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0 \
+};
+
 /* Layer: Numbers / symbols - generated from numbers */
 
 static const int num_keys_numbers_fr = 36;
@@ -774,6 +916,14 @@ static const int switcher_dests_numbers_fr[] = { \
     3, 0, 4 \
 };
 
+static const uint8_t key_classes_numbers_fr[] = { \
+    0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 3, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0 \
+};
+
 /* Layer: Symbols - generated from symbols */
 
 static const int num_keys_symbols_fr = 36;
@@ -808,6 +958,14 @@ static const int switcher_dests_symbols_fr[] = { \
     2, 0, 4 \
 };
 
+static const uint8_t key_classes_symbols_fr[] = { \
+    0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, SQ2LV_KEY_CLASS_SWITCHER | 4, 0 \
+};
+
 /* Layer: Special characters - generated from eschars */
 
 static const int num_keys_special_fr = 36;
@@ -842,6 +1000,14 @@ static const int switcher_dests_special_fr[] = { \
     2, 0, 0 \
 };
 
+static const uint8_t key_classes_special_fr[] = { \
+    0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 2, 0, 0, 0, 0, 0, 0, 0, 0, \
+    SQ2LV_KEY_CLASS_SWITCHER | 0, 0, 0, 0, SQ2LV_KEY_CLASS_SWITCHER | 0, 0 \
+};
+
 /* Layer array */
 
 static const int num_layers_fr = 5;
@@ -855,7 +1021,8 @@ static const sq2lv_layer_t layers_fr[] = {
         .modifier_idxs = modifier_idxs_lower_fr,
         .num_switchers = num_switchers_lower_fr,
         .switcher_idxs = switcher_idxs_lower_fr,
-        .switcher_dests = switcher_dests_lower_fr
+        .switcher_dests = switcher_dests_lower_fr,
+        .key_classes = key_classes_lower_fr
     },
     {
         .num_keys = num_keys_upper_fr,
@@ -865,7 +1032,8 @@ static const sq2lv_layer_t layers_fr[] = {
         .modifier_idxs = modifier_idxs_upper_fr,
         .num_switchers = num_switchers_upper_fr,
         .switcher_idxs = switcher_idxs_upper_fr,
-        .switcher_dests = switcher_dests_upper_fr
+        .switcher_dests = switcher_dests_upper_fr,
+        .key_classes = key_classes_upper_fr
     },
     {
         .num_keys = num_keys_numbers_fr,
@@ -875,7 +1043,8 @@ static const sq2lv_layer_t layers_fr[] = {
         .modifier_idxs = modifier_idxs_numbers_fr,
         .num_switchers = num_switchers_numbers_fr,
         .switcher_idxs = switcher_idxs_numbers_fr,
-        .switcher_dests = switcher_dests_numbers_fr
+        .switcher_dests = switcher_dests_numbers_fr,
+        .key_classes = key_classes_numbers_fr
     },
     {
         .num_keys = num_keys_symbols_fr,
@@ -885,7 +1054,8 @@ static const sq2lv_layer_t layers_fr[] = {
         .modifier_idxs = modifier_idxs_symbols_fr,
         .num_switchers = num_switchers_symbols_fr,
         .switcher_idxs = switcher_idxs_symbols_fr,
-        .switcher_dests = switcher_dests_symbols_fr
+        .switcher_dests = switcher_dests_symbols_fr,
+        .key_classes = key_classes_symbols_fr
     },
     {
         .num_keys = num_keys_special_fr,
@@ -895,7 +1065,8 @@ static const sq2lv_layer_t layers_fr[] = {
         .modifier_idxs = modifier_idxs_special_fr,
         .num_switchers = num_switchers_special_fr,
         .switcher_idxs = switcher_idxs_special_fr,
-        .switcher_dests = switcher_dests_special_fr
+        .switcher_dests = switcher_dests_special_fr,
+        .key_classes = key_classes_special_fr
     }
 };
 
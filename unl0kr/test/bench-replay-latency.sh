@@ -0,0 +1,87 @@
+#!/bin/bash
+
+# Replay synthetic taps on the on-screen keyboard for every layout and report the input latency.
+# Rendering happens headlessly via the memory backend so this doesn't need a display.
+
+log=tmp.log
+conf=tmp.conf
+trace=tmp.trace
+raw=tmp.raw
+
+width=800
+height=480
+layouts_file="$(dirname "${BASH_SOURCE[0]}")/../sq2lv_layouts.c"
+
+source "$(dirname "${BASH_SOURCE[0]}")/helpers.sh"
+
+function clean_up() {
+    rm -f "$log" "$conf" "$trace" "$raw"
+}
+
+trap clean_up EXIT
+
+function write_trace() {
+    # Keyboard geometry as computed in main.c for landscape displays
+    local keyboard_height=$((height / 2 * 5 / 4))
+    local row_height=$((keyboard_height / 5))
+    local top=$((height - keyboard_height))
+    local time=500
+
+    echo "# Taps on the top four keyboard rows (the bottom row holds the enter key)" > "$trace"
+    for round in 1 2 3; do
+        for row in 0 1 2 3; do
+            for column in 0 1 2 3 4 5 6 7 8 9; do
+                local x=$((width / 10 * column + width / 20))
+                local y=$((top + row_height * row + row_height / 2))
+                echo "$time touch $x $y pressed" >> "$trace"
+                echo "$((time + 50)) touch $x $y released" >> "$trace"
+                time=$((time + 150))
+            done
+        done
+    done
+}
+
+function write_config() {
+    cat << EOF > "$conf"
+[general]
+backend=memory
+
+[keyboard]
+autohide=false
+layout=$1
+popovers=true
+
+[memory]
+path=$raw
+width=$width
+height=$height
+EOF
+}
+
+if [[ ! -x ./_build/unl0kr ]]; then
+    error "Could not find executable at ./_build/unl0kr"
+    exit 1
+fi
+
+write_trace
+
+for layout in $(grep -o 'short_name_[a-z]* = "[a-z]*"' "$layouts_file" | cut -d '"' -f 2); do
+    write_config "$layout"
+
+    ./_build/unl0kr -v -C "$conf" -p "$trace" > "$log" 2>&1 &
+    pid=$!
+
+    # Wait for the replay to finish
+    for i in $(seq 1 60); do
+        if grep -q "Replay finished" "$log"; then
+            break
+        fi
+        sleep 1
+    done
+
+    kill -9 $pid
+    wait $pid > /dev/null 2>&1
+
+    result=$(grep -o "Replay finished.*" "$log")
+    echo "$layout: ${result:-replay did not finish}"
+done
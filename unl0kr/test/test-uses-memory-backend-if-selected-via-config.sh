@@ -0,0 +1,43 @@
+#!/bin/bash
+
+log=tmp.log
+conf=tmp.conf
+raw=tmp.raw
+
+source "$(dirname "${BASH_SOURCE[0]}")/helpers.sh"
+
+function clean_up() {
+    rm -f "$log" "$conf" "$raw"
+}
+
+trap clean_up EXIT
+
+info "Writing config"
+cat << EOF > "$conf"
+[general]
+backend=memory
+
+[memory]
+path=$raw
+width=320
+height=240
+format=rgb565
+EOF
+
+info "Running unl0kr"
+run_unl0kr_async "$log" "$conf"
+
+info "Verifying output"
+if ! grep "Using memory backend" "$log"; then
+    error "Expected memory backend to be selected"
+    cat "$log"
+    exit 1
+fi
+
+if [[ $(stat -c %s "$raw") != $((320 * 240 * 2)) ]]; then
+    error "Expected $raw to hold a 320x240 RGB565 frame"
+    ls -l "$raw"
+    exit 1
+fi
+
+ok
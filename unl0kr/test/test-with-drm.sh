@@ -8,4 +8,5 @@ run_script "$root/build-with-drm.sh"
 run_script "$root/test-version-matches-meson-and-changelog.sh"
 run_script "$root/test-uses-fb-backend-by-default.sh"
 run_script "$root/test-uses-fb-backend-if-selected-via-config.sh"
+run_script "$root/test-uses-memory-backend-if-selected-via-config.sh"
 run_script "$root/test-uses-drm-backend-if-selected-via-config-and-available.sh"
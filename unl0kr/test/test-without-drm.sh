@@ -8,4 +8,5 @@ run_script "$root/build-without-drm.sh"
 run_script "$root/test-version-matches-meson-and-changelog.sh"
 run_script "$root/test-uses-fb-backend-by-default.sh"
 run_script "$root/test-uses-fb-backend-if-selected-via-config.sh"
+run_script "$root/test-uses-memory-backend-if-selected-via-config.sh"
 run_script "$root/test-uses-fb-backend-if-drm-selected-via-config-but-unavailable.sh"